@@ -0,0 +1,124 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// emulated call-graph profiling
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "callgraph.hpp"
+
+// -------------------------------------------------------------------------- //
+
+CCallGraph * gCallGraph { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+CCallGraph::CCallGraph() {
+  mNodes.emplace_back();
+  mNodes.back().label = "<entry>";
+}
+
+// -------------------------------------------------------------------------- //
+
+void CCallGraph::call(
+  std::string_view const label
+) {
+  auto const it = mNodes[mCurrent].children.find(label);
+
+  if (it != mNodes[mCurrent].children.end()) {
+    mCurrent = it->second;
+  } else {
+    size_t const node { mNodes.size() };
+    size_t const parent { mCurrent };
+
+    mNodes.emplace_back();
+    mNodes.back().parent = parent;
+    mNodes.back().label = (label.empty() ? "<entry>" : label);
+    mNodes[parent].children.emplace(std::string { label }, node);
+    mCurrent = node;
+  }
+
+  ++mDepth;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CCallGraph::ret() {
+  if (mDepth == 0) {
+    return;
+  }
+
+  mCurrent = mNodes[mCurrent].parent;
+  --mDepth;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CCallGraph::retire(
+  uint64_t const cycle
+) {
+  CNode & node { mNodes[mCurrent] };
+  ++node.instructions;
+
+  if (cycle > mCycle) {
+    node.cycles += (cycle - mCycle);
+    mCycle = cycle;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CCallGraph::depth() const {
+  return mDepth;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CCallGraph::fold(
+  std::ostream & stream,
+  bool const cycles
+) const {
+  // deep emulated recursion makes an equally deep tree, so it is walked with
+  // an explicit stack of (node, length of the parent's stack text) entries
+  std::vector<std::pair<size_t, size_t>> pending { { 0, 0 } };
+  std::string stack;
+
+  while (!pending.empty()) {
+    auto const [node, size] = pending.back();
+    pending.pop_back();
+
+    stack.resize(size);
+
+    if (!stack.empty()) {
+      stack.push_back(';');
+    }
+
+    stack.append(mNodes[node].label);
+
+    uint64_t const weight {
+      cycles ? mNodes[node].cycles : mNodes[node].instructions
+    };
+
+    if (weight > 0) {
+      stream << stack << ' ' << weight << '\n';
+    }
+
+    // pushed in reverse so children are still written in label order
+    auto const & children { mNodes[node].children };
+
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      pending.emplace_back(it->second, stack.size());
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
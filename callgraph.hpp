@@ -0,0 +1,64 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_CALLGRAPH_HPP
+#define INCLUDE_CALLGRAPH_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------- //
+
+// shadow call stack driven by linking branches (calls) and non-linking
+// branches to LR (returns). retired instructions and estimated cycles are
+// attributed to the stack that was active when they executed.
+
+class CCallGraph {
+
+  public:
+
+  CCallGraph();
+
+  void call(std::string_view label);
+  void ret();
+  void retire(uint64_t cycle);
+
+  size_t depth() const;
+
+  // writes folded stacks ("a;b;c weight") as consumed by flamegraph.pl
+  void fold(std::ostream & stream, bool cycles) const;
+
+  private:
+
+  struct CNode {
+
+    size_t parent { 0 };
+    std::string label;
+    std::map<std::string, size_t, std::less<>> children;
+    uint64_t instructions { 0 };
+    uint64_t cycles { 0 };
+
+  };
+
+  std::vector<CNode> mNodes;
+  size_t mCurrent { 0 };
+  size_t mDepth { 0 };
+  uint64_t mCycle { 0 };
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern CCallGraph * gCallGraph;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
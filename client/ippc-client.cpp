@@ -0,0 +1,202 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// client for ippc --serve
+// -------------------------------------------------------------------------- //
+
+// runs a program on a warm ippc server instead of starting ippc. takes the
+// same input and limit arguments as ippc, prints the program output and
+// diagnostics and exits with the status ippc would have. the server socket
+// is named by IPPC_SOCKET (default: ippc.sock).
+//
+//   ippc-client [--max-instructions=N] [--timeout=MS] <input>
+//
+// an input of "-" reads the program from stdin.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// -------------------------------------------------------------------------- //
+
+static bool ReadAll(
+  int const fd,
+  void * const data,
+  size_t const size
+) {
+  char * const bytes { static_cast<char *>(data) };
+  size_t done { 0 };
+
+  while (done < size) {
+    ssize_t const n { read(fd, (bytes + done), (size - done)) };
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      return false;
+    }
+
+    done += size_t(n);
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool WriteAll(
+  int const fd,
+  void const * const data,
+  size_t const size
+) {
+  char const * const bytes { static_cast<char const *>(data) };
+  size_t done { 0 };
+
+  while (done < size) {
+    ssize_t const n { write(fd, (bytes + done), (size - done)) };
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      return false;
+    }
+
+    done += size_t(n);
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool ReadBlock(
+  int const fd,
+  std::string & block
+) {
+  uint32_t size { 0 };
+
+  if (!ReadAll(fd, &size, sizeof(size))) {
+    return false;
+  }
+
+  block.resize(size);
+  return ReadAll(fd, block.data(), size);
+}
+
+// -------------------------------------------------------------------------- //
+
+int main(
+  int const argc,
+  char ** const argv
+) {
+  uint64_t max_instructions { 0 };
+  uint32_t timeout { 0 };
+  char const * input { nullptr };
+
+  for (int i { 1 }; i < argc; ++i) {
+    std::string_view const arg { argv[i] };
+
+    if (arg.substr(0, 19) == "--max-instructions=") {
+      max_instructions = std::strtoull((argv[i] + 19), nullptr, 10);
+    } else if (arg.substr(0, 10) == "--timeout=") {
+      timeout = uint32_t(std::strtoul((argv[i] + 10), nullptr, 10));
+    } else if (input == nullptr && (arg == "-" || arg.substr(0, 1) != "-")) {
+      input = argv[i];
+    } else {
+      std::cerr << "usage: ippc-client [--max-instructions=N] ";
+      std::cerr << "[--timeout=MS] <input>" << std::endl;
+      return 1;
+    }
+  }
+
+  if (input == nullptr) {
+    std::cerr << "usage: ippc-client [--max-instructions=N] ";
+    std::cerr << "[--timeout=MS] <input>" << std::endl;
+    return 1;
+  }
+
+  std::string program;
+
+  if (std::string_view { input } == "-") {
+    program.assign(std::istreambuf_iterator<char> { std::cin }, {});
+  } else {
+    std::ifstream file { input, std::ios::binary };
+
+    if (!file.is_open()) {
+      std::cerr << "failed to open file." << std::endl;
+      return 1;
+    }
+
+    program.assign(std::istreambuf_iterator<char> { file }, {});
+  }
+
+  char const * path { std::getenv("IPPC_SOCKET") };
+
+  if (path == nullptr) {
+    path = "ippc.sock";
+  }
+
+  sockaddr_un address {};
+  address.sun_family = AF_UNIX;
+
+  std::string_view const name { path };
+
+  if (name.size() >= sizeof(address.sun_path)) {
+    std::cerr << "bad socket path." << std::endl;
+    return 1;
+  }
+
+  std::copy(name.begin(), name.end(), address.sun_path);
+
+  int const connection { socket(AF_UNIX, SOCK_STREAM, 0) };
+
+  if (connection < 0 || connect(
+    connection, reinterpret_cast<sockaddr *>(&address), sizeof(address)
+  ) != 0) {
+    std::cerr << "failed to connect to '" << name << "'." << std::endl;
+    return 1;
+  }
+
+  uint32_t const size { uint32_t(program.size()) };
+  int32_t status { 0 };
+  std::string output;
+  std::string diagnostics;
+
+  if (!WriteAll(connection, &max_instructions, sizeof(max_instructions)) ||
+      !WriteAll(connection, &timeout, sizeof(timeout)) ||
+      !WriteAll(connection, &size, sizeof(size)) ||
+      !WriteAll(connection, program.data(), size) ||
+      !ReadAll(connection, &status, sizeof(status)) ||
+      !ReadBlock(connection, output) ||
+      !ReadBlock(connection, diagnostics)) {
+    std::cerr << "lost connection to server." << std::endl;
+    return 1;
+  }
+
+  close(connection);
+
+  std::fwrite(output.data(), 1, output.size(), stdout);
+  std::fwrite(diagnostics.data(), 1, diagnostics.size(), stderr);
+  return status;
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
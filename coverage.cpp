@@ -0,0 +1,102 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// edge coverage
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/shm.h>
+#endif
+
+#include "coverage.hpp"
+
+// -------------------------------------------------------------------------- //
+
+CCoverage * gCoverage { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+CCoverage::CCoverage() :
+  mLocal { new uint8_t[MAP_SIZE] }
+{
+  std::memset(mLocal, 0, MAP_SIZE);
+  mMap = mLocal;
+}
+
+// -------------------------------------------------------------------------- //
+
+CCoverage::~CCoverage() {
+#if defined(__unix__) || defined(__APPLE__)
+  if (mMap != mLocal) {
+    shmdt(mMap);
+  }
+#endif
+
+  delete[] mLocal;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CCoverage::attach() {
+#if defined(__unix__) || defined(__APPLE__)
+  char const * const id { std::getenv(SHM_ENV) };
+
+  if (id == nullptr) {
+    return false;
+  }
+
+  void * const map { shmat(std::atoi(id), nullptr, 0) };
+
+  if (map == reinterpret_cast<void *>(-1)) {
+    return false;
+  }
+
+  mMap = static_cast<uint8_t *>(map);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+void CCoverage::clear() {
+  std::memset(mMap, 0, MAP_SIZE);
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CCoverage::edges() const {
+  return static_cast<size_t>(
+    std::count_if(mMap, (mMap + MAP_SIZE), [] (uint8_t const n) {
+      return (n != 0);
+    })
+  );
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CCoverage::write(
+  std::string const & path
+) const {
+  std::ofstream stream { path, std::ios::binary };
+
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  stream.write(reinterpret_cast<char const *>(mMap), MAP_SIZE);
+  return stream.good();
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
@@ -0,0 +1,65 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_COVERAGE_HPP
+#define INCLUDE_COVERAGE_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// -------------------------------------------------------------------------- //
+
+// AFL-style edge coverage: each taken branch bumps one byte of a 64 KiB map,
+// indexed by a hash of the branch's line and the line it lands on. the map
+// lives either in a shared-memory segment named by the environment or in
+// local memory that is written to a file.
+
+class CCoverage {
+
+  public:
+
+  static constexpr size_t MAP_SIZE { size_t(1) << 16 };
+
+  // environment variable holding the id of a System V segment to record into
+  static constexpr char const * SHM_ENV { "__AFL_SHM_ID" };
+
+  CCoverage();
+  ~CCoverage();
+
+  CCoverage(CCoverage const &) = delete;
+  CCoverage & operator=(CCoverage const &) = delete;
+
+  // records into the segment named by SHM_ENV; false if unset or unavailable
+  bool attach();
+
+  inline void edge(size_t const site, size_t const target) {
+    uint32_t const hash {
+      (uint32_t(site) * 0x9E3779B1u) ^ (uint32_t(target) * 0x85EBCA6Bu)
+    };
+
+    ++mMap[hash >> 16];
+  }
+
+  void clear();
+  size_t edges() const;
+
+  bool write(std::string const & path) const;
+
+  private:
+
+  uint8_t * mMap { nullptr };
+  uint8_t * mLocal { nullptr };
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern CCoverage * gCoverage;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
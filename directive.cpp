@@ -1,19 +1,24 @@
 
 // ========================================================================== //
 
-#include <algorithm>
 #include <cstddef>
-#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
 #include <iostream>
-#include <iterator>
 #include <optional>
-#include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "directive.hpp"
+#include "echo.hpp"
+#include "forkserver.hpp"
 #include "interpreter.hpp"
+#include "output.hpp"
 #include "processor.hpp"
+#include "snapshot.hpp"
 
 // -------------------------------------------------------------------------- //
 
@@ -21,14 +26,6 @@ CDirective * CDirective::sFirst { nullptr };
 
 // -------------------------------------------------------------------------- //
 
-static bool PrintRegistre(
-  std::ostringstream & echo,
-  std::string_view key,
-  std::string_view style
-);
-
-// -------------------------------------------------------------------------- //
-
 CDirective::CDirective(
   std::string_view const key,
   FCallback const callback
@@ -45,6 +42,22 @@ CDirective::CDirective(
 static CDirective sDir_exit {
   ".exit",
   [] () {
+    int32_t code { 0 };
+    gInterpreter->skipSpace();
+
+    if (!gInterpreter->cursor().empty()) {
+      std::optional<int32_t> const code_opt { gInterpreter->readInt() };
+
+      if (code_opt == std::nullopt) {
+        gInterpreter->error();
+        std::cerr << "bad exit code." << std::endl;
+        return false;
+      }
+
+      code = *code_opt;
+    }
+
+    gInterpreter->exit(code);
     return false;
   }
 };
@@ -54,379 +67,457 @@ static CDirective sDir_exit {
 static CDirective sDir_echo {
   ".echo",
   [] () {
-    std::optional<std::string> string_opt {
+    CEcho const * const echo { gInterpreter->echo() };
+
+    if (echo == nullptr) {
+      return false;
+    }
+
+    echo->print(*gOutput);
+    return true;
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CDirective sDir_dump {
+  ".dump",
+  [] () {
+    gInterpreter->skipSpace();
+    std::optional<int32_t> const addr { gInterpreter->readInt() };
+
+    if (addr == std::nullopt) {
+      gInterpreter->error();
+      std::cerr << "bad dump address." << std::endl;
+      return false;
+    }
+
+    if (!gInterpreter->expect(',')) {
+      return false;
+    }
+
+    std::optional<int32_t> const size { gInterpreter->readInt() };
+
+    if (size == std::nullopt || *size < 0) {
+      gInterpreter->error();
+      std::cerr << "bad dump size." << std::endl;
+      return false;
+    }
+
+    if (!gInterpreter->expect(',')) {
+      return false;
+    }
+
+    std::optional<std::string> const path {
       gInterpreter->readString()
     };
 
-    if (string_opt == std::nullopt) {
+    if (path == std::nullopt) {
       return false;
     }
 
-    std::string_view cursor {
-      string_opt->data(),
-      string_opt->size()
+    uint8_t const * const data {
+      std::as_const(*gPPC).host(uint32_t(*addr), size_t(*size))
     };
 
-    std::ostringstream echo;
+    if (data == nullptr) {
+      gInterpreter->error();
+      std::cerr << "dump range is not mapped." << std::endl;
+      return false;
+    }
 
-    do {
-      auto start = std::find(
-        cursor.begin(), cursor.end(), '{'
-      );
-
-      if (start != cursor.begin()) {
-        echo << cursor.substr(
-          0, std::distance(cursor.begin(), start)
-        );
-      }
+    std::ofstream file { *path, std::ios::binary };
+
+    if (
+      !file.is_open() ||
+      !file.write(reinterpret_cast<char const *>(data), *size)
+    ) {
+      gInterpreter->error();
+      std::cerr << "failed to write '" << *path << "'" << std::endl;
+      return false;
+    }
 
-      if (start == cursor.end()) {
-        break;
+    return true;
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CDirective sDir_incbin {
+  ".incbin",
+  [] () {
+    gInterpreter->skipSpace();
+    std::optional<int32_t> const addr { gInterpreter->readInt() };
+
+    if (addr == std::nullopt) {
+      gInterpreter->error();
+      std::cerr << "bad incbin address." << std::endl;
+      return false;
+    }
+
+    if (!gInterpreter->expect(',')) {
+      return false;
+    }
+
+    std::optional<std::string> const path {
+      gInterpreter->readString()
+    };
+
+    if (path == std::nullopt) {
+      return false;
+    }
+
+    std::ifstream file { *path, (std::ios::binary | std::ios::ate) };
+
+    if (!file.is_open()) {
+      gInterpreter->error();
+      std::cerr << "failed to open '" << *path << "'" << std::endl;
+      return false;
+    }
+
+    auto const size = static_cast<size_t>(file.tellg());
+    uint8_t * const data { gPPC->host(uint32_t(*addr), size) };
+
+    if (data == nullptr) {
+      gInterpreter->error();
+      std::cerr << "incbin range is not mapped." << std::endl;
+      return false;
+    }
+
+    // read straight into emulated RAM; there is no intermediate buffer
+    file.seekg(0);
+
+    if (!file.read(reinterpret_cast<char *>(data), size)) {
+      gInterpreter->error();
+      std::cerr << "failed to read '" << *path << "'" << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CDirective sDir_fill {
+  ".fill",
+  [] () {
+    gInterpreter->skipSpace();
+    std::optional<int32_t> const addr { gInterpreter->readInt() };
+
+    if (addr == std::nullopt) {
+      gInterpreter->error();
+      std::cerr << "bad fill address." << std::endl;
+      return false;
+    }
+
+    if (!gInterpreter->expect(',')) {
+      return false;
+    }
+
+    std::optional<int32_t> const size { gInterpreter->readInt() };
+
+    if (size == std::nullopt || *size < 0) {
+      gInterpreter->error();
+      std::cerr << "bad fill size." << std::endl;
+      return false;
+    }
+
+    int32_t value { 0 };
+    gInterpreter->skipSpace();
+
+    if (!gInterpreter->cursor().empty()) {
+      if (!gInterpreter->expect(',')) {
+        return false;
       }
 
-      ++start;
+      std::optional<int32_t> const value_opt { gInterpreter->readInt() };
 
-      if (start == cursor.end()) {
+      if (value_opt == std::nullopt) {
         gInterpreter->error();
-        std::cerr << "bad print sequence." << std::endl;
+        std::cerr << "bad fill value." << std::endl;
         return false;
       }
 
-      if (*start == '{') {
-        cursor = cursor.substr(
-          (std::distance(cursor.begin(), start) + 1)
-        );
+      value = *value_opt;
+    }
 
-        echo << '{';
-        continue;
-      }
+    uint8_t * const data { gPPC->host(uint32_t(*addr), size_t(*size)) };
+
+    if (data == nullptr) {
+      gInterpreter->error();
+      std::cerr << "fill range is not mapped." << std::endl;
+      return false;
+    }
+
+    std::memset(data, uint8_t(value), size_t(*size));
+    return true;
+  }
+};
 
-      cursor = cursor.substr(
-        std::distance(cursor.begin(), start)
-      );
+// -------------------------------------------------------------------------- //
 
-      auto const end = std::find(
-        cursor.begin(), cursor.end(), '}'
-      );
+static CDirective sDir_word {
+  ".word",
+  [] () {
+    gInterpreter->skipSpace();
+    std::optional<int32_t> const addr { gInterpreter->readInt() };
 
-      if (end == cursor.end()) {
-        gInterpreter->error();
-        std::cerr << "bad print sequence." << std::endl;
+    if (addr == std::nullopt) {
+      gInterpreter->error();
+      std::cerr << "bad word address." << std::endl;
+      return false;
+    }
+
+    size_t ea { uint32_t(*addr) };
+
+    do {
+      if (!gInterpreter->expect(',')) {
         return false;
       }
 
-      auto const middle = std::find(
-        cursor.begin(), end, ':'
-      );
-
-      std::string_view const key {
-        cursor.substr(0, std::distance(cursor.begin(), middle))
-      };
+      std::optional<int32_t> const value { gInterpreter->readInt() };
 
-      if (key.empty()) {
+      if (value == std::nullopt) {
         gInterpreter->error();
-        std::cerr << "bad print sequence." << std::endl;
+        std::cerr << "bad word value." << std::endl;
         return false;
       }
 
-      std::string_view style;
+      gPPC->stw(ea, uint32_t(*value));
+      ea += 4;
+      gInterpreter->skipSpace();
+    } while (!gInterpreter->cursor().empty());
+
+    return true;
+  }
+};
+
+// -------------------------------------------------------------------------- //
 
-      if (middle != end) {
-        style = cursor.substr(
-          (std::distance(cursor.begin(), middle) + 1),
-          (std::distance(middle, end) - 1)
-        );
+static CDirective sDir_float {
+  ".float",
+  [] () {
+    gInterpreter->skipSpace();
+    std::optional<int32_t> const addr { gInterpreter->readInt() };
 
-        if (style.empty()) {
-          gInterpreter->error();
-          std::cerr << "bad print sequence." << std::endl;
-          return false;
-        }
+    if (addr == std::nullopt) {
+      gInterpreter->error();
+      std::cerr << "bad float address." << std::endl;
+      return false;
+    }
+
+    size_t ea { uint32_t(*addr) };
+
+    do {
+      if (!gInterpreter->expect(',')) {
+        return false;
       }
 
-      if (!PrintRegistre(echo, key, style)) {
+      std::optional<double> const value { gInterpreter->readFloat() };
+
+      if (value == std::nullopt) {
+        gInterpreter->error();
+        std::cerr << "bad float value." << std::endl;
         return false;
       }
 
-      cursor = cursor.substr(
-        (std::distance(cursor.begin(), end) + 1)
-      );
-    } while (!cursor.empty());
+      gPPC->stfs(ea, static_cast<float>(*value));
+      ea += 4;
+      gInterpreter->skipSpace();
+    } while (!gInterpreter->cursor().empty());
 
-    std::cout << echo.str() << std::endl;
     return true;
   }
 };
 
 // -------------------------------------------------------------------------- //
 
-CDirective const *
-CDirective::Fetch(
-  std::string_view const key
-) {
-  CDirective const * it;
+static CDirective sDir_snapshot {
+  ".snapshot",
+  [] () {
+    gInterpreter->skipSpace();
 
-  for (it = sFirst; it != nullptr; it = it->next) {
-    if (it->key == key) {
-      return it;
+    std::optional<std::string> const path {
+      gInterpreter->readString()
+    };
+
+    if (path == std::nullopt) {
+      return false;
     }
-  }
 
-  return nullptr;
-}
+    // execution resumes on the line after this one when restored
+    CSnapshot snapshot;
+    snapshot.capture(*gPPC, *gInterpreter);
+
+    if (!snapshot.write(*path)) {
+      gInterpreter->error();
+      std::cerr << "failed to write '" << *path << "'" << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+};
 
 // -------------------------------------------------------------------------- //
 
-bool PrintRegistre(
-  std::ostringstream & echo,
-  std::string_view const key,
-  std::string_view style
-) {
-  if (key[0] == 'r') {
-    size_t index;
+static CDirective sDir_restore {
+  ".restore",
+  [] () {
+    gInterpreter->skipSpace();
 
-    if (
-      (key.size() == 2) &&
-      ('0' <= key[1] && key[1] <= '9')
-    ) {
-      index = static_cast<size_t>(key[1] - '0');
-    } else if (
-      (key.size() == 3) &&
-      ('0' <= key[1] && key[1] <= '9') &&
-      ('0' <= key[2] && key[2] <= '9')
-    ) {
-      index = static_cast<size_t>(
-        (key[1] - '0') * 10 + (key[2] - '0')
-      );
-    } else {
+    std::optional<std::string> const path {
+      gInterpreter->readString()
+    };
+
+    if (path == std::nullopt) {
+      return false;
+    }
+
+    CSnapshot snapshot;
+
+    if (!snapshot.read(*path)) {
       gInterpreter->error();
-      std::cerr << "bad print sequence." << std::endl;
+      std::cerr << "failed to read '" << *path << "'" << std::endl;
       return false;
     }
 
-    if (index > 32) {
+    ERestore const restored { snapshot.restore(*gPPC, *gInterpreter) };
+
+    if (restored == ERESTORE_PROGRAM) {
       gInterpreter->error();
-      std::cerr << "bad print sequence." << std::endl;
-      return false;
-    }
-
-    CGPR const & gpr { gPPC->gpr(index) };
-
-    if (style.empty()) {
-      echo << gpr.s32();
-    } else {
-      bool next { true };
-
-      while (!style.empty() && next) {
-        switch (style[0]) {
-          case '-': {
-            echo << std::right;
-            break;
-          }
-          case '+': {
-            echo << std::showpos;
-            break;
-          }
-          case '#': {
-            echo << std::showbase;
-            break;
-          }
-          case '0': {
-            echo << std::setfill('0');
-            break;
-          }
-          default: {
-            next = false;
-            break;
-          }
-        }
-
-        if (next) {
-          style = style.substr(1);
-        }
-      }
+      std::cerr << "snapshot '" << *path << "' belongs to a different program";
+      std::cerr << std::endl;
+      return false;
+    }
 
-      size_t width { 0 };
+    if (restored != ERESTORE_OK) {
+      gInterpreter->error();
+      std::cerr << "bad snapshot '" << *path << "'" << std::endl;
+      return false;
+    }
 
-      while (
-        !style.empty() &&
-        ('0' <= style[0] && style[0] <= '9')
-      ) {
-        width = (width * 10 + (style[0] - '0'));
-        style = style.substr(1);
-      }
+    return true;
+  }
+};
 
-      echo.width(width);
+// -------------------------------------------------------------------------- //
 
-      if (style.size() != 1) {
-        gInterpreter->error();
-        std::cerr << "bad print sequence." << std::endl;
-        return false;
-      }
+// .fuzz ADDR, SIZE, rN marks where fuzz inputs enter the program: up to SIZE
+// bytes are placed at ADDR and their count in rN. without a fork server the
+// input is empty.
 
-      switch (style[0]) {
-        case 'd':
-        case 'i': {
-          echo << gpr.s32();
-          break;
-        }
-        case 'u': {
-          echo << gpr.u32();
-          break;
-        }
-        case 'x':
-        case 'X': {
-          if (style[0] == 'X') {
-            echo << std::uppercase;
-          }
-
-          echo << std::hex << gpr.u32();
-          break;
-        }
-        default: {
-          gInterpreter->error();
-          std::cerr << "bad print sequence." << std::endl;
-          return false;
-        }
-      }
+static CDirective sDir_fuzz {
+  ".fuzz",
+  [] () {
+    gInterpreter->skipSpace();
+    std::optional<int32_t> const addr { gInterpreter->readInt() };
+
+    if (addr == std::nullopt) {
+      gInterpreter->error();
+      std::cerr << "bad fuzz buffer address." << std::endl;
+      return false;
     }
-  } else if (key[0] == 'f') {
-    size_t index;
 
-    if (
-      (key.size() == 2) &&
-      ('0' <= key[1] && key[1] <= '9')
-    ) {
-      index = static_cast<size_t>(key[1] - '0');
-    } else if (
-      (key.size() == 3) &&
-      ('0' <= key[1] && key[1] <= '9') &&
-      ('0' <= key[2] && key[2] <= '9')
-    ) {
-      index = static_cast<size_t>(
-        (key[1] - '0') * 10 + (key[2] - '0')
-      );
-    } else {
+    if (!gInterpreter->expect(',')) {
+      return false;
+    }
+
+    std::optional<int32_t> const size { gInterpreter->readInt() };
+
+    if (size == std::nullopt || *size < 0) {
       gInterpreter->error();
-      std::cerr << "bad print sequence." << std::endl;
+      std::cerr << "bad fuzz buffer size." << std::endl;
+      return false;
+    }
+
+    if (!gInterpreter->expect(',')) {
       return false;
     }
 
-    if (index > 32) {
+    gInterpreter->skipSpace();
+
+    if (gInterpreter->cursor().empty() || gInterpreter->cursor()[0] != 'r') {
       gInterpreter->error();
-      std::cerr << "bad print sequence." << std::endl;
-      return false;
-    }
-
-    CFPR const & fpr { gPPC->fpr(index) };
-
-    if (style.empty()) {
-      echo << fpr.f64();
-    } else {
-      bool next { true };
-
-      while (!style.empty() && next) {
-        switch (style[0]) {
-          case '-': {
-            echo << std::right;
-            break;
-          }
-          case '+': {
-            echo << std::showpos;
-            break;
-          }
-          case '#': {
-            echo << std::showpoint;
-            break;
-          }
-          case '0': {
-            echo << std::setfill('0');
-            break;
-          }
-          default: {
-            next = false;
-            break;
-          }
-        }
-
-        if (next) {
-          style = style.substr(1);
-        }
-      }
+      std::cerr << "bad fuzz length register." << std::endl;
+      return false;
+    }
 
-      size_t width { 0 };
+    gInterpreter->skip(1);
+    std::optional<int32_t> const reg { gInterpreter->readInt(10) };
 
-      while (
-        !style.empty() &&
-        ('0' <= style[0] && style[0] <= '9')
-      ) {
-        width = (width * 10 + (style[0] - '0'));
-        style = style.substr(1);
-      }
+    if (reg == std::nullopt || *reg < 0 || *reg > 31) {
+      gInterpreter->error();
+      std::cerr << "bad fuzz length register." << std::endl;
+      return false;
+    }
 
-      echo.width(width);
+    if (gPPC->host(uint32_t(*addr), size_t(*size)) == nullptr) {
+      gInterpreter->error();
+      std::cerr << "fuzz buffer is not mapped." << std::endl;
+      return false;
+    }
 
-      if (!style.empty() && style[0] == '.') {
-        style = style.substr(1);
-        size_t precision { 0 };
+    gPPC->gpr(size_t(*reg)) = CGPR { 0u };
 
-        while (
-          !style.empty() &&
-          ('0' <= style[0] && style[0] <= '9')
-        ) {
-          precision = (precision * 10 + (style[0] - '0'));
-          style = style.substr(1);
-        }
+    if (gForkServer != nullptr) {
+      gForkServer->arm(uint32_t(*addr), uint32_t(*size), size_t(*reg));
+      return false;
+    }
 
-        echo.precision(precision);
-      }
+    return true;
+  }
+};
 
-      if (style.size() != 1) {
-        gInterpreter->error();
-        std::cerr << "bad print sequence." << std::endl;
-        return false;
-      }
+// -------------------------------------------------------------------------- //
 
-      switch (style[0]) {
-        case 'f': {
-          echo << fpr.f64();
-          break;
-        }
-        case 'h': {
-          echo << fpr.ps0();
-          break;
-        }
-        case 'l': {
-          echo << fpr.ps1();
-          break;
-        }
-        case 'u': {
-          echo << fpr.u64();
-          break;
-        }
-        case 'x':
-        case 'X': {
-          if (style[0] == 'X') {
-            echo << std::uppercase;
-          }
-
-          echo << std::hex << fpr.u64();
-          break;
-        }
-        default: {
-          gInterpreter->error();
-          std::cerr << "bad print sequence." << std::endl;
-          return false;
-        }
-      }
+// .macro NAME [PARAM[=DEFAULT], ...] ... .endm and .rept N ... .endr; see
+// CInterpreter::macro()
+
+static CDirective sDir_macro {
+  ".macro",
+  [] () {
+    return gInterpreter->macro();
+  }
+};
+
+static CDirective sDir_endm {
+  ".endm",
+  [] () {
+    return gInterpreter->endMacro();
+  }
+};
+
+static CDirective sDir_rept {
+  ".rept",
+  [] () {
+    return gInterpreter->repeat();
+  }
+};
+
+static CDirective sDir_endr {
+  ".endr",
+  [] () {
+    return gInterpreter->endRepeat();
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+CDirective const *
+CDirective::Fetch(
+  std::string_view const key
+) {
+  CDirective const * it;
+
+  for (it = sFirst; it != nullptr; it = it->next) {
+    if (it->key == key) {
+      return it;
     }
-  } else {
-    gInterpreter->error();
-    std::cerr << "bad print sequence." << std::endl;
-    return false;
   }
 
-  return true;
+  return nullptr;
 }
 
 // -------------------------------------------------------------------------- //
@@ -0,0 +1,572 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// compiled .echo formats
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "echo.hpp"
+#include "interpreter.hpp"
+#include "output.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+static void PrintPadded(
+  COutput & output,
+  CEchoOp const & op,
+  std::string_view prefix,
+  std::string_view body
+);
+
+static void PrintInteger(
+  COutput & output,
+  CEchoOp const & op,
+  uint64_t magnitude,
+  bool negative
+);
+
+static void PrintWord(
+  COutput & output,
+  CEchoOp const & op,
+  uint32_t value
+);
+
+static void PrintFloat(
+  COutput & output,
+  CEchoOp const & op,
+  double value
+);
+
+// -------------------------------------------------------------------------- //
+
+std::optional<CEcho>
+CEcho::Compile(
+  std::string_view cursor
+) {
+  CEcho echo;
+
+  do {
+    auto start = std::find(
+      cursor.begin(), cursor.end(), '{'
+    );
+
+    if (start != cursor.begin()) {
+      echo.text(cursor.substr(
+        0, std::distance(cursor.begin(), start)
+      ));
+    }
+
+    if (start == cursor.end()) {
+      break;
+    }
+
+    ++start;
+
+    if (start == cursor.end()) {
+      gInterpreter->error();
+      std::cerr << "bad print sequence." << std::endl;
+      return std::nullopt;
+    }
+
+    if (*start == '{') {
+      cursor = cursor.substr(
+        (std::distance(cursor.begin(), start) + 1)
+      );
+
+      echo.text("{");
+      continue;
+    }
+
+    cursor = cursor.substr(
+      std::distance(cursor.begin(), start)
+    );
+
+    auto const end = std::find(
+      cursor.begin(), cursor.end(), '}'
+    );
+
+    if (end == cursor.end()) {
+      gInterpreter->error();
+      std::cerr << "bad print sequence." << std::endl;
+      return std::nullopt;
+    }
+
+    auto const middle = std::find(
+      cursor.begin(), end, ':'
+    );
+
+    std::string_view const key {
+      cursor.substr(0, std::distance(cursor.begin(), middle))
+    };
+
+    std::string_view style;
+
+    if (middle != end) {
+      style = cursor.substr(
+        (std::distance(cursor.begin(), middle) + 1),
+        (std::distance(middle, end) - 1)
+      );
+
+      if (style.empty()) {
+        gInterpreter->error();
+        std::cerr << "bad print sequence." << std::endl;
+        return std::nullopt;
+      }
+    }
+
+    CEchoOp op;
+
+    if (key.empty() || !CompileKey(op, key, style)) {
+      gInterpreter->error();
+      std::cerr << "bad print sequence." << std::endl;
+      return std::nullopt;
+    }
+
+    echo.mOps.push_back(op);
+
+    cursor = cursor.substr(
+      (std::distance(cursor.begin(), end) + 1)
+    );
+  } while (!cursor.empty());
+
+  echo.text("\n");
+  return echo;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CEcho::print(
+  COutput & output
+) const {
+  for (CEchoOp const & op : mOps) {
+    switch (op.key) {
+      case EECHO_TEXT: {
+        output.write({ (mText.data() + op.offset), op.size });
+        break;
+      }
+      case EECHO_GPR: {
+        PrintWord(output, op, gPPC->gpr(op.index).u32());
+        break;
+      }
+      case EECHO_MEM: {
+        uint32_t value;
+
+        switch (op.index) {
+          case 1: {
+            value = gPPC->lbz(op.address);
+
+            if (op.conversion == 'd' || op.conversion == 'i') {
+              value = uint32_t(int32_t(int8_t(value)));
+            }
+
+            break;
+          }
+          case 2: {
+            value = gPPC->lhz(op.address);
+
+            if (op.conversion == 'd' || op.conversion == 'i') {
+              value = uint32_t(int32_t(int16_t(value)));
+            }
+
+            break;
+          }
+          default: {
+            value = gPPC->lwz(op.address);
+            break;
+          }
+        }
+
+        PrintWord(output, op, value);
+        break;
+      }
+      case EECHO_CR: {
+        // architectural field order: LT is the most-significant bit
+        uint8_t const cr { gPPC->cr(op.index) };
+        uint32_t value { 0 };
+
+        if (cr & ECR_LT) { value |= 0b1000; }
+        if (cr & ECR_GT) { value |= 0b0100; }
+        if (cr & ECR_EQ) { value |= 0b0010; }
+        if (cr & ECR_SO) { value |= 0b0001; }
+
+        PrintWord(output, op, value);
+        break;
+      }
+      case EECHO_LR: {
+        PrintWord(output, op, gPPC->lr());
+        break;
+      }
+      case EECHO_CTR: {
+        PrintWord(output, op, gPPC->ctr());
+        break;
+      }
+      case EECHO_XER: {
+        PrintWord(output, op, gPPC->mfspr(ESPR_XER));
+        break;
+      }
+      case EECHO_FPR: {
+        CFPR const & fpr { gPPC->fpr(op.index) };
+
+        switch (op.conversion) {
+          case 'f': {
+            PrintFloat(output, op, fpr.f64());
+            break;
+          }
+          case 'h': {
+            PrintFloat(output, op, fpr.ps0());
+            break;
+          }
+          case 'l': {
+            PrintFloat(output, op, fpr.ps1());
+            break;
+          }
+          default: {
+            PrintInteger(output, op, fpr.u64(), false);
+            break;
+          }
+        }
+
+        break;
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CEcho::text(
+  std::string_view const text
+) {
+  // adjacent literal runs are merged into a single write
+  if (!mOps.empty() && mOps.back().key == EECHO_TEXT) {
+    mOps.back().size += uint32_t(text.size());
+  } else {
+    CEchoOp op;
+    op.offset = uint32_t(mText.size());
+    op.size = uint32_t(text.size());
+    mOps.push_back(op);
+  }
+
+  mText.append(text);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CEcho::CompileKey(
+  CEchoOp & op,
+  std::string_view const key,
+  std::string_view style
+) {
+  op.conversion = 'd';
+
+  if (key == "lr") {
+    op.key = EECHO_LR;
+  } else if (key == "ctr") {
+    op.key = EECHO_CTR;
+  } else if (key == "xer") {
+    op.key = EECHO_XER;
+  } else if (
+    (key.size() == 3) && (key.substr(0, 2) == "cr") &&
+    ('0' <= key[2] && key[2] <= '7')
+  ) {
+    op.key = EECHO_CR;
+    op.index = uint8_t(key[2] - '0');
+  } else if (key == "m8" || key == "m16" || key == "m32") {
+    op.key = EECHO_MEM;
+    op.index = uint8_t(key == "m8" ? 1 : key == "m16" ? 2 : 4);
+
+    // the address comes first and is followed by an optional style
+    std::string_view address { style };
+    size_t const colon { style.find(':') };
+
+    if (colon != std::string_view::npos) {
+      address = style.substr(0, colon);
+      style = style.substr(colon + 1);
+
+      if (style.empty()) {
+        return false;
+      }
+    } else {
+      style = { };
+    }
+
+    int base { 10 };
+
+    if (address.size() > 2 && address[0] == '0' && (
+      address[1] == 'x' || address[1] == 'X'
+    )) {
+      address = address.substr(2);
+      base = 16;
+    }
+
+    auto const result = std::from_chars(
+      address.data(), (address.data() + address.size()), op.address, base
+    );
+
+    if (
+      (address.empty()) ||
+      (result.ec != std::errc { }) ||
+      (result.ptr != (address.data() + address.size()))
+    ) {
+      return false;
+    }
+
+    if (std::as_const(*gPPC).host(op.address, op.index) == nullptr) {
+      return false;
+    }
+  } else {
+    if (key[0] == 'r') {
+      op.key = EECHO_GPR;
+    } else if (key[0] == 'f') {
+      op.key = EECHO_FPR;
+      op.conversion = 'f';
+    } else {
+      return false;
+    }
+
+    if (
+      (key.size() == 2) &&
+      ('0' <= key[1] && key[1] <= '9')
+    ) {
+      op.index = uint8_t(key[1] - '0');
+    } else if (
+      (key.size() == 3) &&
+      ('0' <= key[1] && key[1] <= '9') &&
+      ('0' <= key[2] && key[2] <= '9')
+    ) {
+      op.index = uint8_t((key[1] - '0') * 10 + (key[2] - '0'));
+    } else {
+      return false;
+    }
+
+    if (op.index > 31) {
+      return false;
+    }
+  }
+
+  if (style.empty()) {
+    return true;
+  }
+
+  bool next { true };
+
+  while (!style.empty() && next) {
+    switch (style[0]) {
+      case '-': {
+        break;
+      }
+      case '+': {
+        op.flags |= EECHO_SIGN;
+        break;
+      }
+      case '#': {
+        op.flags |= EECHO_BASE;
+        break;
+      }
+      case '0': {
+        op.flags |= EECHO_ZERO;
+        break;
+      }
+      default: {
+        next = false;
+        break;
+      }
+    }
+
+    if (next) {
+      style = style.substr(1);
+    }
+  }
+
+  while (
+    !style.empty() &&
+    ('0' <= style[0] && style[0] <= '9')
+  ) {
+    op.width = uint16_t(op.width * 10 + (style[0] - '0'));
+    style = style.substr(1);
+  }
+
+  if (op.key == EECHO_FPR && !style.empty() && style[0] == '.') {
+    style = style.substr(1);
+    op.precision = 0;
+
+    while (
+      !style.empty() &&
+      ('0' <= style[0] && style[0] <= '9')
+    ) {
+      op.precision = int16_t(op.precision * 10 + (style[0] - '0'));
+      style = style.substr(1);
+    }
+  }
+
+  if (style.size() != 1) {
+    return false;
+  }
+
+  op.conversion = style[0];
+
+  switch (op.conversion) {
+    case 'd':
+    case 'i': {
+      return (op.key != EECHO_FPR);
+    }
+    case 'f':
+    case 'h':
+    case 'l': {
+      return (op.key == EECHO_FPR);
+    }
+    case 'u':
+    case 'x':
+    case 'X': {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+void PrintPadded(
+  COutput & output,
+  CEchoOp const & op,
+  std::string_view const prefix,
+  std::string_view const body
+) {
+  size_t const length { prefix.size() + body.size() };
+  size_t const padding { op.width > length ? (op.width - length) : 0 };
+
+  if (!(op.flags & EECHO_ZERO)) {
+    for (size_t i { 0 }; i < padding; ++i) {
+      output.put(' ');
+    }
+  }
+
+  output.write(prefix);
+
+  if (op.flags & EECHO_ZERO) {
+    for (size_t i { 0 }; i < padding; ++i) {
+      output.put('0');
+    }
+  }
+
+  output.write(body);
+}
+
+// -------------------------------------------------------------------------- //
+
+void PrintInteger(
+  COutput & output,
+  CEchoOp const & op,
+  uint64_t const magnitude,
+  bool const negative
+) {
+  bool const hex { op.conversion == 'x' || op.conversion == 'X' };
+  char digits[24];
+
+  auto const result = std::to_chars(
+    std::begin(digits), std::end(digits), magnitude, (hex ? 16 : 10)
+  );
+
+  if (op.conversion == 'X') {
+    std::transform(
+      std::begin(digits), result.ptr, std::begin(digits),
+      [] (char const c) {
+        return char(('a' <= c && c <= 'f') ? (c - 'a' + 'A') : c);
+      }
+    );
+  }
+
+  std::string_view prefix;
+
+  if (negative) {
+    prefix = "-";
+  } else if (hex && (op.flags & EECHO_BASE)) {
+    prefix = (op.conversion == 'X' ? "0X" : "0x");
+  } else if (
+    (op.flags & EECHO_SIGN) &&
+    (op.conversion == 'd' || op.conversion == 'i')
+  ) {
+    prefix = "+";
+  }
+
+  PrintPadded(
+    output, op, prefix,
+    { std::data(digits), size_t(result.ptr - std::data(digits)) }
+  );
+}
+
+// -------------------------------------------------------------------------- //
+
+void PrintWord(
+  COutput & output,
+  CEchoOp const & op,
+  uint32_t const value
+) {
+  if (op.conversion == 'd' || op.conversion == 'i') {
+    int64_t const signed_value { int32_t(value) };
+
+    PrintInteger(
+      output, op,
+      uint64_t(signed_value < 0 ? -signed_value : signed_value),
+      (signed_value < 0)
+    );
+  } else {
+    PrintInteger(output, op, value, false);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void PrintFloat(
+  COutput & output,
+  CEchoOp const & op,
+  double const value
+) {
+  int const precision { op.precision < 0 ? 6 : op.precision };
+  char digits[352];
+  size_t size { 0 };
+
+  if (op.flags & EECHO_BASE) {
+    int const count {
+      std::snprintf(digits, sizeof(digits), "%#.*g", precision, value)
+    };
+
+    size = size_t(std::clamp(count, 0, int(sizeof(digits) - 1)));
+  } else {
+    auto const result = std::to_chars(
+      std::begin(digits), std::end(digits), value,
+      std::chars_format::general, precision
+    );
+
+    size = size_t(result.ptr - std::data(digits));
+  }
+
+  std::string_view body { digits, size };
+  std::string_view prefix;
+
+  if (!body.empty() && body[0] == '-') {
+    prefix = "-";
+    body = body.substr(1);
+  } else if (op.flags & EECHO_SIGN) {
+    prefix = "+";
+  }
+
+  PrintPadded(output, op, prefix, body);
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
@@ -0,0 +1,88 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_ECHO_HPP
+#define INCLUDE_ECHO_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "output.hpp"
+
+// -------------------------------------------------------------------------- //
+
+enum EEchoKey : uint8_t {
+
+  EECHO_TEXT,
+  EECHO_GPR,
+  EECHO_FPR,
+  EECHO_MEM, // {m8:ADDR}, {m16:ADDR}, {m32:ADDR}
+  EECHO_CR,
+  EECHO_LR,
+  EECHO_CTR,
+  EECHO_XER,
+
+};
+
+enum EEchoFlag : uint8_t {
+
+  EECHO_SIGN  = 0b0000'0001, // '+': always print a sign
+  EECHO_BASE  = 0b0000'0010, // '#': base prefix (ints) or decimal point (floats)
+  EECHO_ZERO  = 0b0000'0100, // '0': pad with zeroes after the sign/prefix
+
+};
+
+// -------------------------------------------------------------------------- //
+
+struct CEchoOp {
+
+  EEchoKey key { EECHO_TEXT };
+  uint8_t index { 0 };
+  uint8_t flags { 0 };
+  char conversion { 0 };
+  uint16_t width { 0 };
+  int16_t precision { -1 };
+  uint32_t offset { 0 };
+  uint32_t size { 0 };
+  uint32_t address { 0 };
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// an .echo format string compiled to a list of literal runs and register or
+// memory keys, so that executing the directive does no parsing.
+
+class CEcho {
+
+  public:
+
+  static std::optional<CEcho> Compile(std::string_view format);
+
+  void print(COutput & output) const;
+
+  private:
+
+  std::string mText;
+  std::vector<CEchoOp> mOps;
+
+  void text(std::string_view text);
+
+  static bool CompileKey(
+    CEchoOp & op,
+    std::string_view key,
+    std::string_view style
+  );
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,63 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// write-gather pipe device
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "fifo.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+void CFifo::attach(
+  CProcessor & processor,
+  size_t const addr
+) {
+  processor.mmio(
+    addr, CProcessor::PAGE_SIZE,
+    [] (size_t, size_t) {
+      return 0u;
+    },
+    [this] (size_t, size_t const size, uint32_t const value) {
+      for (size_t i { size }; i > 0; --i) {
+        mData.push_back(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+      }
+    }
+  );
+}
+
+// -------------------------------------------------------------------------- //
+
+std::vector<uint8_t> const &
+CFifo::data() const {
+  return mData;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CFifo::write(
+  std::string const & path
+) const {
+  std::ofstream stream { path, std::ios::binary };
+
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  stream.write(
+    reinterpret_cast<char const *>(mData.data()),
+    static_cast<std::streamsize>(mData.size())
+  );
+
+  return stream.good();
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
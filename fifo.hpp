@@ -0,0 +1,41 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_FIFO_HPP
+#define INCLUDE_FIFO_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// a stand-in for the write-gather pipe: every store to its page is appended
+// to a byte stream in guest order, and loads read back zero.
+
+class CFifo {
+
+  public:
+
+  static constexpr size_t ADDRESS { 0xCC008000 };
+
+  void attach(CProcessor & processor, size_t addr = ADDRESS);
+
+  std::vector<uint8_t> const & data() const;
+  bool write(std::string const & path) const;
+
+  private:
+
+  std::vector<uint8_t> mData;
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,162 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// persistent-mode fuzzing driver
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include "coverage.hpp"
+#include "forkserver.hpp"
+#include "interpreter.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+CForkServer * gForkServer { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+CForkServer::CForkServer(
+  std::FILE * const input,
+  std::FILE * const output
+) :
+  mInput { input },
+  mOutput { output }
+{ }
+
+// -------------------------------------------------------------------------- //
+
+void CForkServer::arm(
+  uint32_t const addr,
+  uint32_t const size,
+  size_t const reg
+) {
+  mArmed = true;
+  mAddr = addr;
+  mSize = size;
+  mReg = reg;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CForkServer::armed() const {
+  return mArmed;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CForkServer::visit(
+  size_t const line
+) {
+  if (line >= mLines.size()) {
+    mLines.resize((line + 1) * 2, 0);
+  }
+
+  if (mLines[line] == 0) {
+    mLines[line] = 1;
+    ++mCovered;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+int CForkServer::serve(
+  CProcessor & processor,
+  CInterpreter & interpreter
+) {
+  // the marker state: memory and registers via the processor baseline, the
+  // interpreter position (just after .fuzz) via its own serialization
+  processor.baseline();
+
+#ifdef _WIN32
+  // the protocol is binary; text mode would rewrite 0x0A and stop at 0x1A
+  _setmode(_fileno(mInput), _O_BINARY);
+  _setmode(_fileno(mOutput), _O_BINARY);
+#endif
+
+  std::ostringstream position_stream { std::ios::binary };
+  interpreter.save(position_stream);
+  std::string const position { std::move(position_stream).str() };
+
+  std::vector<uint8_t> input;
+  input.reserve(mSize);
+
+  for (;;) {
+    uint32_t size { 0 };
+
+    if (std::fread(&size, sizeof(size), 1, mInput) != 1) {
+      return 0;
+    }
+
+    input.resize(size);
+
+    if (size > 0 && std::fread(input.data(), 1, size, mInput) != size) {
+      return 1;
+    }
+
+    processor.reset();
+
+    std::istringstream position_input { position, std::ios::binary };
+
+    if (!interpreter.load(position_input)) {
+      std::cerr << "failed to restore the marker state." << std::endl;
+      return 1;
+    }
+
+    interpreter.restart();
+
+    // oversized inputs are truncated to the buffer the program declared
+    size_t const length { std::min<size_t>(size, mSize) };
+
+    if (length > 0) {
+      std::memcpy(processor.host(mAddr, length), input.data(), length);
+    }
+
+    processor.gpr(mReg) = CGPR { uint32_t(length) };
+
+    std::fill(mLines.begin(), mLines.end(), 0);
+    mCovered = 0;
+
+    if (gCoverage != nullptr) {
+      gCoverage->clear();
+    }
+
+    interpreter.run();
+
+    int32_t status { interpreter.exitCode().value_or(-1) };
+
+    if (processor.faulted()) {
+      status = -2;
+    } else if (interpreter.halted() == EHALT_INSTRUCTIONS) {
+      status = -3;
+    } else if (interpreter.halted() == EHALT_TIMEOUT) {
+      status = -4;
+    }
+
+    uint64_t const operations { interpreter.executed() };
+
+    std::fwrite(&status, sizeof(status), 1, mOutput);
+    std::fwrite(&mCovered, sizeof(mCovered), 1, mOutput);
+    std::fwrite(&operations, sizeof(operations), 1, mOutput);
+    std::fflush(mOutput);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
@@ -0,0 +1,69 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_FORKSERVER_HPP
+#define INCLUDE_FORKSERVER_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "interpreter.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// persistent-mode driver for fuzzing. the program runs once up to its .fuzz
+// marker; from then on every request read from the input stream is copied
+// into RAM at the marker's buffer, the program runs from the marker to .exit
+// and the machine is reset to the marker state for the next request.
+//
+// request:  uint32 size, then size bytes of input
+// response: int32 status (.exit code, -1 on error, -2 on a DSI, -3 or -4 when
+//           stopped by --max-instructions or --timeout), uint32 lines
+//           covered, uint64 operations executed
+//
+// limits apply to each request separately.
+//
+// all fields are in host byte order.
+
+class CForkServer {
+
+  public:
+
+  explicit CForkServer(std::FILE * input = stdin, std::FILE * output = stdout);
+
+  void arm(uint32_t addr, uint32_t size, size_t reg);
+  bool armed() const;
+
+  // marks a line as covered for the current request
+  void visit(size_t line);
+
+  // serves requests until the input stream is closed
+  int serve(CProcessor & processor, CInterpreter & interpreter);
+
+  private:
+
+  std::FILE * mInput { nullptr };
+  std::FILE * mOutput { nullptr };
+  bool mArmed { false };
+  uint32_t mAddr { 0 };
+  uint32_t mSize { 0 };
+  size_t mReg { 0 };
+  std::vector<uint8_t> mLines;
+  uint32_t mCovered { 0 };
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern CForkServer * gForkServer;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -7,12 +7,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <ios>
 #include <optional>
 
+#include "callgraph.hpp"
 #include "instruction.hpp"
 #include "interpreter.hpp"
+#include "predictor.hpp"
 #include "processor.hpp"
 #include "span.hpp"
+#include "timing.hpp"
 
 // -------------------------------------------------------------------------- //
 
@@ -26,8 +30,14 @@ enum : uint8_t {
 
 // -------------------------------------------------------------------------- //
 
+static void TrackCall(bool lk, std::optional<uint32_t> target);
+
+// -------------------------------------------------------------------------- //
+
 void b(bool lk, std::optional<uint32_t> ll);
-void bc(uint8_t bo, uint8_t bi, bool lk, std::optional<uint32_t> bd);
+void bc(
+  uint8_t bo, uint8_t bi, bool lk, std::optional<uint32_t> bd, uint8_t bits
+);
 
 // -------------------------------------------------------------------------- //
 
@@ -87,14 +97,14 @@ static CInstruction sInst_bctrl {
 
 static CInstruction sInst_blt {
   "blt", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + LT), false, std::nullopt);
+    bc(0b01100, (4 * cr + LT), false, std::nullopt, bits);
   }
 };
 
@@ -102,14 +112,14 @@ static CInstruction sInst_blt {
 
 static CInstruction sInst_bltlr {
   "bltlr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + LT), false, gPPC->lr());
+    bc(0b01100, (4 * cr + LT), false, gPPC->lr(), bits);
   }
 };
 
@@ -117,14 +127,14 @@ static CInstruction sInst_bltlr {
 
 static CInstruction sInst_bltctr {
   "bltctr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + LT), false, gPPC->ctr());
+    bc(0b01100, (4 * cr + LT), false, gPPC->ctr(), bits);
   }
 };
 
@@ -132,14 +142,14 @@ static CInstruction sInst_bltctr {
 
 static CInstruction sInst_bltl {
   "bltl", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + LT), true, std::nullopt);
+    bc(0b01100, (4 * cr + LT), true, std::nullopt, bits);
   }
 };
 
@@ -147,14 +157,14 @@ static CInstruction sInst_bltl {
 
 static CInstruction sInst_bltlrl {
   "bltlrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + LT), true, gPPC->lr());
+    bc(0b01100, (4 * cr + LT), true, gPPC->lr(), bits);
   }
 };
 
@@ -162,14 +172,14 @@ static CInstruction sInst_bltlrl {
 
 static CInstruction sInst_bltctrl {
   "bltctrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + LT), true, gPPC->ctr());
+    bc(0b01100, (4 * cr + LT), true, gPPC->ctr(), bits);
   }
 };
 
@@ -177,14 +187,14 @@ static CInstruction sInst_bltctrl {
 
 static CInstruction sInst_ble {
   "ble", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), false, std::nullopt);
+    bc(0b00100, (4 * cr + GT), false, std::nullopt, bits);
   }
 };
 
@@ -192,14 +202,14 @@ static CInstruction sInst_ble {
 
 static CInstruction sInst_blelr {
   "blelr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), false, gPPC->lr());
+    bc(0b00100, (4 * cr + GT), false, gPPC->lr(), bits);
   }
 };
 
@@ -207,14 +217,14 @@ static CInstruction sInst_blelr {
 
 static CInstruction sInst_blectr {
   "blectr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), false, gPPC->ctr());
+    bc(0b00100, (4 * cr + GT), false, gPPC->ctr(), bits);
   }
 };
 
@@ -222,14 +232,14 @@ static CInstruction sInst_blectr {
 
 static CInstruction sInst_blel {
   "blel", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), true, std::nullopt);
+    bc(0b00100, (4 * cr + GT), true, std::nullopt, bits);
   }
 };
 
@@ -237,14 +247,14 @@ static CInstruction sInst_blel {
 
 static CInstruction sInst_blelrl {
   "blelrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), true, gPPC->lr());
+    bc(0b00100, (4 * cr + GT), true, gPPC->lr(), bits);
   }
 };
 
@@ -252,14 +262,14 @@ static CInstruction sInst_blelrl {
 
 static CInstruction sInst_blectrl {
   "blectrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), true, gPPC->ctr());
+    bc(0b00100, (4 * cr + GT), true, gPPC->ctr(), bits);
   }
 };
 
@@ -267,14 +277,14 @@ static CInstruction sInst_blectrl {
 
 static CInstruction sInst_beq {
   "beq", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + EQ), false, std::nullopt);
+    bc(0b01100, (4 * cr + EQ), false, std::nullopt, bits);
   }
 };
 
@@ -282,14 +292,14 @@ static CInstruction sInst_beq {
 
 static CInstruction sInst_beqlr {
   "beqlr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + EQ), false, gPPC->lr());
+    bc(0b01100, (4 * cr + EQ), false, gPPC->lr(), bits);
   }
 };
 
@@ -297,14 +307,14 @@ static CInstruction sInst_beqlr {
 
 static CInstruction sInst_beqctr {
   "beqctr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + EQ), false, gPPC->ctr());
+    bc(0b01100, (4 * cr + EQ), false, gPPC->ctr(), bits);
   }
 };
 
@@ -312,14 +322,14 @@ static CInstruction sInst_beqctr {
 
 static CInstruction sInst_beql {
   "beql", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + EQ), true, std::nullopt);
+    bc(0b01100, (4 * cr + EQ), true, std::nullopt, bits);
   }
 };
 
@@ -327,14 +337,14 @@ static CInstruction sInst_beql {
 
 static CInstruction sInst_beqlrl {
   "beqlrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + EQ), true, gPPC->lr());
+    bc(0b01100, (4 * cr + EQ), true, gPPC->lr(), bits);
   }
 };
 
@@ -342,14 +352,14 @@ static CInstruction sInst_beqlrl {
 
 static CInstruction sInst_beqctrl {
   "beqctrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + EQ), true, gPPC->ctr());
+    bc(0b01100, (4 * cr + EQ), true, gPPC->ctr(), bits);
   }
 };
 
@@ -357,14 +367,14 @@ static CInstruction sInst_beqctrl {
 
 static CInstruction sInst_bge {
   "bge", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), false, std::nullopt);
+    bc(0b00100, (4 * cr + LT), false, std::nullopt, bits);
   }
 };
 
@@ -372,14 +382,14 @@ static CInstruction sInst_bge {
 
 static CInstruction sInst_bgelr {
   "bgelr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), false, gPPC->lr());
+    bc(0b00100, (4 * cr + LT), false, gPPC->lr(), bits);
   }
 };
 
@@ -387,14 +397,14 @@ static CInstruction sInst_bgelr {
 
 static CInstruction sInst_bgectr {
   "bgectr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), false, gPPC->ctr());
+    bc(0b00100, (4 * cr + LT), false, gPPC->ctr(), bits);
   }
 };
 
@@ -402,14 +412,14 @@ static CInstruction sInst_bgectr {
 
 static CInstruction sInst_bgel {
   "bgel", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), true, std::nullopt);
+    bc(0b00100, (4 * cr + LT), true, std::nullopt, bits);
   }
 };
 
@@ -417,14 +427,14 @@ static CInstruction sInst_bgel {
 
 static CInstruction sInst_bgelrl {
   "bgelrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), true, gPPC->lr());
+    bc(0b00100, (4 * cr + LT), true, gPPC->lr(), bits);
   }
 };
 
@@ -432,14 +442,14 @@ static CInstruction sInst_bgelrl {
 
 static CInstruction sInst_bgectrl {
   "bgectrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), true, gPPC->ctr());
+    bc(0b00100, (4 * cr + LT), true, gPPC->ctr(), bits);
   }
 };
 
@@ -447,14 +457,14 @@ static CInstruction sInst_bgectrl {
 
 static CInstruction sInst_bgt {
   "bgt", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + GT), false, std::nullopt);
+    bc(0b01100, (4 * cr + GT), false, std::nullopt, bits);
   }
 };
 
@@ -462,14 +472,14 @@ static CInstruction sInst_bgt {
 
 static CInstruction sInst_bgtlr {
   "bgtlr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + GT), false, gPPC->lr());
+    bc(0b01100, (4 * cr + GT), false, gPPC->lr(), bits);
   }
 };
 
@@ -477,14 +487,14 @@ static CInstruction sInst_bgtlr {
 
 static CInstruction sInst_bgtctr {
   "bgtctr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + GT), false, gPPC->ctr());
+    bc(0b01100, (4 * cr + GT), false, gPPC->ctr(), bits);
   }
 };
 
@@ -492,14 +502,14 @@ static CInstruction sInst_bgtctr {
 
 static CInstruction sInst_bgtl {
   "bgtl", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + GT), true, std::nullopt);
+    bc(0b01100, (4 * cr + GT), true, std::nullopt, bits);
   }
 };
 
@@ -507,14 +517,14 @@ static CInstruction sInst_bgtl {
 
 static CInstruction sInst_bgtlrl {
   "bgtlrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + GT), true, gPPC->lr());
+    bc(0b01100, (4 * cr + GT), true, gPPC->lr(), bits);
   }
 };
 
@@ -522,14 +532,14 @@ static CInstruction sInst_bgtlrl {
 
 static CInstruction sInst_bgtctrl {
   "bgtctrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b01100, (4 * cr + GT), true, gPPC->ctr());
+    bc(0b01100, (4 * cr + GT), true, gPPC->ctr(), bits);
   }
 };
 
@@ -537,14 +547,14 @@ static CInstruction sInst_bgtctrl {
 
 static CInstruction sInst_bnl {
   "bnl", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), false, std::nullopt);
+    bc(0b00100, (4 * cr + LT), false, std::nullopt, bits);
   }
 };
 
@@ -552,14 +562,14 @@ static CInstruction sInst_bnl {
 
 static CInstruction sInst_bnllr {
   "bnllr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), false, gPPC->lr());
+    bc(0b00100, (4 * cr + LT), false, gPPC->lr(), bits);
   }
 };
 
@@ -567,14 +577,14 @@ static CInstruction sInst_bnllr {
 
 static CInstruction sInst_bnlctr {
   "bnlctr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), false, gPPC->ctr());
+    bc(0b00100, (4 * cr + LT), false, gPPC->ctr(), bits);
   }
 };
 
@@ -582,14 +592,14 @@ static CInstruction sInst_bnlctr {
 
 static CInstruction sInst_bnll {
   "bnll", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), true, std::nullopt);
+    bc(0b00100, (4 * cr + LT), true, std::nullopt, bits);
   }
 };
 
@@ -597,14 +607,14 @@ static CInstruction sInst_bnll {
 
 static CInstruction sInst_bnllrl {
   "bnllrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), true, gPPC->lr());
+    bc(0b00100, (4 * cr + LT), true, gPPC->lr(), bits);
   }
 };
 
@@ -612,14 +622,14 @@ static CInstruction sInst_bnllrl {
 
 static CInstruction sInst_bnlctrl {
   "bnlctrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + LT), true, gPPC->ctr());
+    bc(0b00100, (4 * cr + LT), true, gPPC->ctr(), bits);
   }
 };
 
@@ -627,14 +637,14 @@ static CInstruction sInst_bnlctrl {
 
 static CInstruction sInst_bne {
   "bne", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + EQ), false, std::nullopt);
+    bc(0b00100, (4 * cr + EQ), false, std::nullopt, bits);
   }
 };
 
@@ -642,14 +652,14 @@ static CInstruction sInst_bne {
 
 static CInstruction sInst_bnelr {
   "bnelr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + EQ), false, gPPC->lr());
+    bc(0b00100, (4 * cr + EQ), false, gPPC->lr(), bits);
   }
 };
 
@@ -657,14 +667,14 @@ static CInstruction sInst_bnelr {
 
 static CInstruction sInst_bnectr {
   "bnectr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + EQ), false, gPPC->ctr());
+    bc(0b00100, (4 * cr + EQ), false, gPPC->ctr(), bits);
   }
 };
 
@@ -672,14 +682,14 @@ static CInstruction sInst_bnectr {
 
 static CInstruction sInst_bnel {
   "bnel", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + EQ), true, std::nullopt);
+    bc(0b00100, (4 * cr + EQ), true, std::nullopt, bits);
   }
 };
 
@@ -687,14 +697,14 @@ static CInstruction sInst_bnel {
 
 static CInstruction sInst_bnelrl {
   "bnelrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + EQ), true, gPPC->lr());
+    bc(0b00100, (4 * cr + EQ), true, gPPC->lr(), bits);
   }
 };
 
@@ -702,14 +712,14 @@ static CInstruction sInst_bnelrl {
 
 static CInstruction sInst_bnectrl {
   "bnectrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + EQ), true, gPPC->ctr());
+    bc(0b00100, (4 * cr + EQ), true, gPPC->ctr(), bits);
   }
 };
 
@@ -717,14 +727,14 @@ static CInstruction sInst_bnectrl {
 
 static CInstruction sInst_bng {
   "bng", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), false, std::nullopt);
+    bc(0b00100, (4 * cr + GT), false, std::nullopt, bits);
   }
 };
 
@@ -732,14 +742,14 @@ static CInstruction sInst_bng {
 
 static CInstruction sInst_bnglr {
   "bnglr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), false, gPPC->lr());
+    bc(0b00100, (4 * cr + GT), false, gPPC->lr(), bits);
   }
 };
 
@@ -747,14 +757,14 @@ static CInstruction sInst_bnglr {
 
 static CInstruction sInst_bngctr {
   "bngctr", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), false, gPPC->ctr());
+    bc(0b00100, (4 * cr + GT), false, gPPC->ctr(), bits);
   }
 };
 
@@ -762,14 +772,14 @@ static CInstruction sInst_bngctr {
 
 static CInstruction sInst_bngl {
   "bngl", "[{CR:cr},]{BD:addr}",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), true, std::nullopt);
+    bc(0b00100, (4 * cr + GT), true, std::nullopt, bits);
   }
 };
 
@@ -777,14 +787,14 @@ static CInstruction sInst_bngl {
 
 static CInstruction sInst_bnglrl {
   "bnglrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), true, gPPC->lr());
+    bc(0b00100, (4 * cr + GT), true, gPPC->lr(), bits);
   }
 };
 
@@ -792,14 +802,14 @@ static CInstruction sInst_bnglrl {
 
 static CInstruction sInst_bngctrl {
   "bngctrl", "[{CR:cr}]",
-  [] (CSpanT<int32_t> args, uint8_t) {
+  [] (CSpanT<int32_t> args, uint8_t bits) {
     uint8_t cr { 0 };
 
     if (!args.empty()) {
       cr = uint8_t(args[0]);
     }
 
-    bc(0b00100, (4 * cr + GT), true, gPPC->ctr());
+    bc(0b00100, (4 * cr + GT), true, gPPC->ctr(), bits);
   }
 };
 
@@ -807,8 +817,8 @@ static CInstruction sInst_bngctrl {
 
 static CInstruction sInst_bdz {
   "bdz", "{BD:addr}",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10010, 0, false, std::nullopt);
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10010, 0, false, std::nullopt, bits);
   }
 };
 
@@ -816,8 +826,8 @@ static CInstruction sInst_bdz {
 
 static CInstruction sInst_bdzl {
   "bdzl", "{BD:addr}",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10010, 0, true, std::nullopt);
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10010, 0, true, std::nullopt, bits);
   }
 };
 
@@ -825,8 +835,8 @@ static CInstruction sInst_bdzl {
 
 static CInstruction sInst_bdnz {
   "bdnz", "{BD:addr}",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10000, 0, false, std::nullopt);
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10000, 0, false, std::nullopt, bits);
   }
 };
 
@@ -834,8 +844,8 @@ static CInstruction sInst_bdnz {
 
 static CInstruction sInst_bdnzl {
   "bdnzl", "{BD:addr}",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10000, 0, true, std::nullopt);
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10000, 0, true, std::nullopt, bits);
   }
 };
 
@@ -843,8 +853,8 @@ static CInstruction sInst_bdnzl {
 
 static CInstruction sInst_bdzlr {
   "bdzlr",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10010, 0, false, gPPC->lr());
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10010, 0, false, gPPC->lr(), bits);
   }
 };
 
@@ -852,8 +862,8 @@ static CInstruction sInst_bdzlr {
 
 static CInstruction sInst_bdzlrl {
   "bdzlrl",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10010, 0, true, gPPC->lr());
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10010, 0, true, gPPC->lr(), bits);
   }
 };
 
@@ -861,8 +871,8 @@ static CInstruction sInst_bdzlrl {
 
 static CInstruction sInst_bdnzlr {
   "bdnzlr",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10000, 0, false, gPPC->lr());
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10000, 0, false, gPPC->lr(), bits);
   }
 };
 
@@ -870,8 +880,8 @@ static CInstruction sInst_bdnzlr {
 
 static CInstruction sInst_bdnzlrl {
   "bdnzlrl",
-  [] (CSpanT<int32_t>, uint8_t) {
-    bc(0b10000, 0, true, gPPC->lr());
+  [] (CSpanT<int32_t>, uint8_t bits) {
+    bc(0b10000, 0, true, gPPC->lr(), bits);
   }
 };
 
@@ -881,17 +891,17 @@ void b(
   bool lk,
   std::optional<uint32_t> ll
 ) {
+  if (gCallGraph != nullptr) {
+    TrackCall(lk, ll);
+  }
+
   if (lk) {
     gPPC->lr() = static_cast<uint32_t>(
       gInterpreter->tell()
     );
   }
 
-  if (ll == std::nullopt) {
-    gInterpreter->branch();
-  } else {
-    gInterpreter->seek(*ll);
-  }
+  gInterpreter->jump(ll);
 }
 
 // -------------------------------------------------------------------------- //
@@ -900,7 +910,8 @@ void bc(
   uint8_t bo,
   uint8_t bi,
   bool lk,
-  std::optional<uint32_t> bd
+  std::optional<uint32_t> bd,
+  uint8_t bits
 ) {
   // BO[0] BO[1] BO[2] BO[3] BO[4]
   // 0x10  0x08  0x04  0x02  0x01
@@ -911,27 +922,82 @@ void bc(
     );
   }
 
+  bool taken { true };
+
   if (!(bo & 0x04)) {
     --gPPC->ctr();
 
     if (!((gPPC->ctr() == 0) ^ ((bo & 0x02) == 0))) {
-      return;
+      taken = false;
     }
   }
 
-  if (!(bo & 0x10)) {
+  if (taken && !(bo & 0x10)) {
     uint8_t lhs { gPPC->cr(bi >> 2) };
     auto rhs = static_cast<uint8_t>(1 << (bi & 0x3));
 
     if (!(((lhs & rhs) != 0) ^ ((bo & 0x08) == 0))) {
-      return;
+      taken = false;
     }
   }
 
-  if (bd == std::nullopt) {
-    gInterpreter->branch();
-  } else {
-    gInterpreter->seek(*bd);
+  if (gPredictor != nullptr || gTiming != nullptr) {
+    std::optional<std::streamoff> target;
+
+    if (bd != std::nullopt) {
+      target = std::streamoff(*bd);
+    } else if (auto const label = gInterpreter->target()) {
+      target = std::streamoff(*label);
+    }
+
+    bool const backward {
+      target != std::nullopt &&
+      *target <= std::streamoff(gInterpreter->tell())
+    };
+
+    bool const predicted {
+      CPredictor::Predict(bits, (bd == std::nullopt), backward)
+    };
+
+    if (gPredictor != nullptr) {
+      gPredictor->record(
+        gInterpreter->line(), gInterpreter->region(), predicted, taken
+      );
+    }
+
+    if (gTiming != nullptr && predicted != taken) {
+      gTiming->mispredict(gInterpreter->region());
+    }
+  }
+
+  if (!taken) {
+    return;
+  }
+
+  if (gCallGraph != nullptr) {
+    TrackCall(lk, bd);
+  }
+
+  gInterpreter->jump(bd);
+}
+
+// -------------------------------------------------------------------------- //
+
+void TrackCall(
+  bool const lk,
+  std::optional<uint32_t> const target
+) {
+  // a linking branch is a call; a non-linking branch to LR is a return. the
+  // return test must run before LR is overwritten by a linking branch.
+
+  if (lk) {
+    if (target == std::nullopt) {
+      gCallGraph->call(gInterpreter->label());
+    } else {
+      gCallGraph->call(gInterpreter->regionAt(*target));
+    }
+  } else if (target != std::nullopt && *target == gPPC->lr()) {
+    gCallGraph->ret();
   }
 }
 
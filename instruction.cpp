@@ -42,6 +42,13 @@ CInstruction::Fetch(
   uint8_t * const bits
 ) {
   CInstruction const * it;
+  std::string_view lhs { key };
+  uint8_t hint { 0 };
+
+  if (lhs.size() > 1 && (lhs.back() == '+' || lhs.back() == '-')) {
+    hint = (lhs.back() == '+' ? EBIT_Y : EBIT_N);
+    lhs = lhs.substr(0, (lhs.size() - 1));
+  }
 
   for (it = sFirst; it != nullptr; it = it->next) {
     std::string_view rhs { it->key };
@@ -50,8 +57,19 @@ CInstruction::Fetch(
       *bits = 0;
     }
 
+    // static prediction hints are only accepted on branch mnemonics
+    if (hint != 0) {
+      if (rhs[0] != 'b') {
+        continue;
+      }
+
+      if (bits != nullptr) {
+        *bits |= hint;
+      }
+    }
+
     if (rhs.back() == '.') {
-      if (key.back() != '.') {
+      if (lhs.back() != '.') {
         rhs = rhs.substr(0, (rhs.size() - 1));
       } else if (bits != nullptr) {
         *bits |= EBIT_RC;
@@ -59,14 +77,14 @@ CInstruction::Fetch(
     }
 
     if (rhs.back() == 'o') {
-      if (key.back() != 'o') {
+      if (lhs.back() != 'o') {
         rhs = rhs.substr(0, (rhs.size() - 1));
       } else if (bits != nullptr) {
         *bits |= EBIT_OE;
       }
     }
 
-    if (key == rhs) {
+    if (lhs == rhs) {
       return it;
     }
   }
@@ -54,4 +54,102 @@ static CInstruction sInst_mflr {
 
 // -------------------------------------------------------------------------- //
 
+static CInstruction sInst_mtxer {
+  "mtxer", "{RA:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto ra = size_t(args[0]);
+    gPPC->mtspr(ESPR_XER, gPPC->gpr(ra).u32());
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_mfxer {
+  "mfxer", "{RD:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rd = size_t(args[0]);
+    gPPC->gpr(rd) = CGPR { gPPC->mfspr(ESPR_XER) };
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_mtspr {
+  "mtspr", "{SPR:spr},{RS:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto spr = size_t(args[0]);
+    auto rs = size_t(args[1]);
+    gPPC->mtspr(spr, gPPC->gpr(rs).u32());
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_mfspr {
+  "mfspr", "{RD:gpr},{SPR:spr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rd = size_t(args[0]);
+    auto spr = size_t(args[1]);
+    gPPC->gpr(rd) = CGPR { gPPC->mfspr(spr) };
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_dcbz {
+  "dcbz", "{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto ra = size_t(args[0]);
+    auto rb = size_t(args[1]);
+    gPPC->dcbz(gPPC->ea(ra, rb));
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+// allocates a zeroed line in the locked cache; ippc keeps the locked cache
+// as a fixed scratchpad, so this is dcbz on a scratchpad address
+
+static CInstruction sInst_dcbz_l {
+  "dcbz_l", "{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto ra = size_t(args[0]);
+    auto rb = size_t(args[1]);
+    gPPC->dcbz(gPPC->ea(ra, rb));
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+// there is no data cache to maintain, so flush, store, invalidate and touch
+// have no architectural effect; their cost is accounted for by the timing model
+
+static CInstruction sInst_dcbf {
+  "dcbf", "{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t>, uint8_t) { }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_dcbst {
+  "dcbst", "{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t>, uint8_t) { }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_dcbi {
+  "dcbi", "{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t>, uint8_t) { }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_dcbt {
+  "dcbt", "{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t>, uint8_t) { }
+};
+
+// -------------------------------------------------------------------------- //
+
 // ========================================================================== //
@@ -251,17 +251,68 @@ static CInstruction sInst_lwzux {
 
 // -------------------------------------------------------------------------- //
 
+static CInstruction sInst_lhbrx {
+  "lhbrx", "{RT:gpr},{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rt = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto rb = size_t(args[2]);
+
+    gPPC->gpr(rt) = CGPR {
+      uint32_t(gPPC->lhbrx(gPPC->ea(ra, rb)))
+    };
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_lwbrx {
+  "lwbrx", "{RT:gpr},{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rt = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto rb = size_t(args[2]);
+
+    gPPC->gpr(rt) = CGPR {
+      gPPC->lwbrx(gPPC->ea(ra, rb))
+    };
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
 static CInstruction sInst_lmw {
   "lmw", "{RT:gpr},{D:si}({RA:gpr})",
   [] (CSpanT<int32_t> args, uint8_t) {
     auto rt = size_t(args[0]);
     auto d = int16_t(args[1]);
     auto ra = size_t(args[2]);
-    size_t ea { gPPC->ea(d, ra) };
+    gPPC->lmw(rt, gPPC->ea(d, ra));
+  }
+};
 
-    for (size_t i { 0 }; i < (32 - rt); ++i, ea += 4) {
-      gPPC->gpr(rt + i) = CGPR { gPPC->lwz(ea) };
-    }
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_lswi {
+  "lswi", "{RT:gpr},{RA:gpr},{NB:bit}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rt = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto nb = size_t(args[2]);
+    size_t ea { (ra == 0) ? 0 : size_t(gPPC->gpr(ra).u32()) };
+    gPPC->lsw(rt, ea, ((nb == 0) ? 32 : nb));
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_lswx {
+  "lswx", "{RT:gpr},{RA:gpr},{RB:gpr}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rt = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto rb = size_t(args[2]);
+    gPPC->lsw(rt, gPPC->ea(ra, rb), gPPC->xerCount());
   }
 };
 
@@ -447,18 +498,62 @@ static CInstruction sInst_stwux {
 
 // -------------------------------------------------------------------------- //
 
+static CInstruction sInst_sthbrx {
+  "sthbrx", "{RS:gpr},{RA:gpr}({RB:gpr})",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rs = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto rb = size_t(args[2]);
+    gPPC->sthbrx(gPPC->ea(ra, rb), gPPC->gpr(rs).u16());
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_stwbrx {
+  "stwbrx", "{RS:gpr},{RA:gpr}({RB:gpr})",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rs = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto rb = size_t(args[2]);
+    gPPC->stwbrx(gPPC->ea(ra, rb), gPPC->gpr(rs).u32());
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
 static CInstruction sInst_stmw {
   "stmw", "{RS:gpr},{D:si}({RA:gpr})",
   [] (CSpanT<int32_t> args, uint8_t) {
     auto rs = size_t(args[0]);
     auto d = int16_t(args[1]);
     auto ra = size_t(args[2]);
-    size_t ea { gPPC->ea(d, ra) };
+    gPPC->stmw(rs, gPPC->ea(d, ra));
+  }
+};
 
-    for (size_t i { 0 }; i < (32 - rs); ++i) {
-      gPPC->stw(ea, gPPC->gpr(rs + i).u32());
-      ea += 4;
-    }
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_stswi {
+  "stswi", "{RS:gpr},{RA:gpr},{NB:bit}",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rs = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto nb = size_t(args[2]);
+    size_t ea { (ra == 0) ? 0 : size_t(gPPC->gpr(ra).u32()) };
+    gPPC->stsw(rs, ea, ((nb == 0) ? 32 : nb));
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+static CInstruction sInst_stswx {
+  "stswx", "{RS:gpr},{RA:gpr}({RB:gpr})",
+  [] (CSpanT<int32_t> args, uint8_t) {
+    auto rs = size_t(args[0]);
+    auto ra = size_t(args[1]);
+    auto rb = size_t(args[2]);
+    gPPC->stsw(rs, gPPC->ea(ra, rb), gPPC->xerCount());
   }
 };
 
@@ -15,7 +15,7 @@
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fadds {
-  "fadds.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fadds.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -33,7 +33,7 @@ static CInstruction sInst_fadds {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fsubs {
-  "fsubs.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fsubs.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -51,7 +51,7 @@ static CInstruction sInst_fsubs {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fmuls {
-  "fmuls.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fmuls.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -69,7 +69,7 @@ static CInstruction sInst_fmuls {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fdivs {
-  "fdivs.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fdivs.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -87,7 +87,7 @@ static CInstruction sInst_fdivs {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fmadds {
-  "fmadds.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fmadds.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -108,7 +108,7 @@ static CInstruction sInst_fmadds {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fmsubs {
-  "fmsubs.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fmsubs.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -129,7 +129,7 @@ static CInstruction sInst_fmsubs {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fnmadds {
-  "fnmadds.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fnmadds.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -150,7 +150,7 @@ static CInstruction sInst_fnmadds {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fnmsubs {
-  "fnmsubs.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fnmsubs.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -188,7 +188,7 @@ static CInstruction sInst_fsqrts {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fadd {
-  "fadd.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fadd.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -204,7 +204,7 @@ static CInstruction sInst_fadd {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fsub {
-  "fsub.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fsub.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -220,7 +220,7 @@ static CInstruction sInst_fsub {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fmul {
-  "fmul.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fmul.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -236,7 +236,7 @@ static CInstruction sInst_fmul {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fdiv {
-  "fdiv.", "{FRT:fpr},{FRA:fpr},{FRB:frb}",
+  "fdiv.", "{FRT:fpr},{FRA:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -252,7 +252,7 @@ static CInstruction sInst_fdiv {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fmadd {
-  "fmadd.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fmadd.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -271,7 +271,7 @@ static CInstruction sInst_fmadd {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fmsub {
-  "fmsub.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fmsub.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -290,7 +290,7 @@ static CInstruction sInst_fmsub {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fnmadd {
-  "fnmadd.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fnmadd.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -311,7 +311,7 @@ static CInstruction sInst_fnmadd {
 // -------------------------------------------------------------------------- //
 
 static CInstruction sInst_fnmsub {
-  "fnmsub.", "{FRT:fpr},{FRA:fpr},{FRC:frb},{FRB:frb}",
+  "fnmsub.", "{FRT:fpr},{FRA:fpr},{FRC:fpr},{FRB:fpr}",
   [] (CSpanT<int32_t> args, uint8_t bits) {
     auto frt = size_t(args[0]);
     auto fra = size_t(args[1]);
@@ -21,6 +21,7 @@ enum EBit : uint8_t {
   EBIT_AA = 0b0000'0100, // absolute-address bit
   EBIT_LK = 0b0000'1000, // link bit
   EBIT_Y  = 0b0001'0000, // branch is likely to be taken
+  EBIT_N  = 0b0010'0000, // branch is likely not to be taken
 
 };
 
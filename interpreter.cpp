@@ -4,27 +4,85 @@
 // -------------------------------------------------------------------------- //
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <iomanip>
 #include <ios>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
+#include "callgraph.hpp"
+#include "coverage.hpp"
 #include "directive.hpp"
+#include "forkserver.hpp"
 #include "instruction.hpp"
 #include "interpreter.hpp"
 #include "processor.hpp"
+#include "profiler.hpp"
+#include "snapshot.hpp"
 #include "span.hpp"
+#include "timing.hpp"
 
 // -------------------------------------------------------------------------- //
 
-std::ifstream * gStream { nullptr };
+std::istream * gStream { nullptr };
 CInterpreter * gInterpreter { nullptr };
 
 // -------------------------------------------------------------------------- //
 
+static bool IsNameChar(
+  char const c
+) {
+  return (std::isalnum(static_cast<unsigned char>(c)) || c == '_');
+}
+
+// -------------------------------------------------------------------------- //
+
+// comma-separated operands with the spaces around them removed
+static std::vector<std::string_view> SplitOperands(
+  std::string_view const text
+) {
+  std::vector<std::string_view> operands;
+
+  if (text.find_first_not_of(' ') == std::string_view::npos) {
+    return operands;
+  }
+
+  for (size_t at { 0 }; ; ) {
+    size_t const comma { std::min(text.find(',', at), text.size()) };
+    std::string_view operand { text.substr(at, (comma - at)) };
+    size_t const first { operand.find_first_not_of(' ') };
+
+    if (first == std::string_view::npos) {
+      operand = { };
+    } else {
+      operand = operand.substr(
+        first, (operand.find_last_not_of(' ') - first + 1)
+      );
+    }
+
+    operands.push_back(operand);
+
+    if (comma == text.size()) {
+      return operands;
+    }
+
+    at = (comma + 1);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
 bool CInterpreter::interpret() {
   if (gStream == nullptr) {
     return false;
@@ -34,7 +92,9 @@ bool CInterpreter::interpret() {
   char input_buffer[1024];
 
   if (!gStream->getline(input_buffer, 1024)) {
-    if (mBranchAhead) {
+    if (mSkipDepth != 0) {
+      std::cerr << "missing " << mSkipClose << std::endl;
+    } else if (mBranchAhead) {
       std::cerr << "missing branch target '" << mLabel << "'" << std::endl;
     }
 
@@ -42,6 +102,11 @@ bool CInterpreter::interpret() {
   }
 
   mLine = { std::data(input_buffer), std::strlen(input_buffer) };
+  mSubstituted = false;
+
+  if (!mFrames.empty() && mLine.find('\\') != std::string_view::npos) {
+    substitute(mLine);
+  }
 
   auto const comment = std::find(
     mLine.begin(), mLine.end(), ';'
@@ -60,8 +125,9 @@ bool CInterpreter::interpret() {
   mCursor = mLine;
   skipSpace();
 
+  // blank lines, including those holding only a comment
   if (mCursor.empty()) {
-    return false;
+    return true;
   }
 
   std::string_view const key {
@@ -74,28 +140,79 @@ bool CInterpreter::interpret() {
 
   skipSpace();
 
+  // the body of a macro being defined, or of a .rept 0, is not run
+  if (mSkipDepth != 0) {
+    if (key == mSkipOpen) {
+      ++mSkipDepth;
+    } else if (key == mSkipClose) {
+      --mSkipDepth;
+    }
+
+    return true;
+  }
+
   if (!mCursor.empty() && mCursor[0] == ':') {
     std::string label { key };
-    mLabels[label] = gStream->tellg();
+    CStreamPos const position { gStream->tellg() };
+    mLabels[label] = position;
+    mLabelsByPos[position] = label;
+    mLineNos[position] = mLineNo;
 
-    if (mLabel == label) {
+    if (mLabel == label && mBranchAhead) {
       mBranchAhead = false;
+      mSkippedRepeats = 0;
+
+#ifndef BUILD_NO_COVERAGE
+      if (gCoverage != nullptr) {
+        gCoverage->edge(mSources.key(mBranchSite), mSources.key(mLineNo));
+      }
+#endif
+    }
+
+    if (!mBranchAhead) {
+      mRegion = label;
     }
 
     return true;
   }
 
   if (mBranchAhead) {
-    return true;
+    return skipAhead(key);
   }
 
+  ++mExecuted;
   mArgNo = 0;
   CDirective const * directive { nullptr };
   CInstruction const * instruction { nullptr };
   uint8_t bits { 0 };
 
+  // sampled host time covers lookup and operand parsing as well as the
+  // callback, since that is what an executed line costs the interpreter.
+
+  size_t const line { mLineNo };
+  std::optional<CProfiler::CClock::time_point> start;
+
+  if (gForkServer != nullptr) {
+    gForkServer->visit(line);
+  }
+
+  if (gProfiler != nullptr && gProfiler->sample()) {
+    start = CProfiler::CClock::now();
+  }
+
   if ((directive = CDirective::Fetch(key)) != nullptr) {
-    if (!directive->callback()) {
+    bool const proceed { directive->callback() };
+
+    if (gProfiler != nullptr) {
+      gProfiler->record(directive->key, line, start);
+    }
+
+    if (gPPC->faulted()) {
+      fault();
+      return false;
+    }
+
+    if (!proceed) {
       return false;
     }
   } else if ((instruction = CInstruction::Fetch(key, &bits)) != nullptr) {
@@ -103,7 +220,34 @@ bool CInterpreter::interpret() {
       return false;
     }
 
+    if (gTiming != nullptr) {
+      gTiming->retire(
+        *instruction, { mArgs, mArgNo }, { mArgNames, mArgNo }, mRegion
+      );
+    }
+
+    if (gCallGraph != nullptr) {
+      gCallGraph->retire(gTiming != nullptr ? gTiming->now() : 0);
+    }
+
     instruction->callback({ mArgs, mArgNo }, bits);
+
+    if (gProfiler != nullptr) {
+      gProfiler->record(instruction->key, line, start);
+    }
+
+    if (gPPC->faulted()) {
+      fault();
+      return false;
+    }
+
+    if (mHalt != EHALT_NONE) {
+      return false;
+    }
+  } else if (auto const macro = mMacros.find(key); macro != mMacros.end()) {
+    if (!invoke(macro->second)) {
+      return false;
+    }
   } else {
     error();
     std::cerr << "unknown operation" << std::endl;
@@ -115,15 +259,72 @@ bool CInterpreter::interpret() {
 
 // -------------------------------------------------------------------------- //
 
+ERun CInterpreter::run(
+  std::optional<uint64_t> const budget
+) {
+  if (budget != std::nullopt) {
+    mYieldAt = (mExecuted + *budget);
+    mCheckpoint = std::min(mCheckpoint, mYieldAt);
+  }
+
+  while (interpret());
+
+  mYieldAt = UINT64_MAX;
+
+  if (mHalt != EHALT_YIELD) {
+    return ERUN_STOPPED;
+  }
+
+  // limits are rechecked at the next taken branch
+  mHalt = EHALT_NONE;
+  mCheckpoint = 0;
+  return ERUN_YIELDED;
+}
+
+// -------------------------------------------------------------------------- //
+
 void CInterpreter::branch() {
   if (gStream == nullptr || mLabel.empty()) {
     return;
   }
 
   if (mLabels.count(mLabel) == 1) {
-    gStream->seekg(mLabels[mLabel]);
+    CStreamPos const position { mLabels[mLabel] };
+    gStream->seekg(position);
+    mLineNo = mLineNos[position];
+    mRegion = mLabel;
   } else {
     mBranchAhead = true;
+    mSkippedRepeats = 0;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::jump(
+  std::optional<uint32_t> const target
+) {
+  size_t const site { mLineNo };
+
+  if (target == std::nullopt) {
+    branch();
+  } else {
+    seek(*target);
+  }
+
+#ifndef BUILD_NO_COVERAGE
+  // forward branches to unseen labels land once the scan reaches the label
+  if (gCoverage != nullptr) {
+    if (mBranchAhead) {
+      mBranchSite = site;
+    } else {
+      gCoverage->edge(mSources.key(site), mSources.key(mLineNo));
+    }
+  }
+#endif
+
+  if (mExecuted >= mCheckpoint) {
+    checkLimits();
   }
 }
 
@@ -137,6 +338,12 @@ void CInterpreter::seek(
   }
 
   gStream->seekg(position);
+
+  if (auto const line = mLineNos.find(position); line != mLineNos.end()) {
+    mLineNo = line->second;
+  }
+
+  mRegion = regionAt(position);
 }
 
 // -------------------------------------------------------------------------- //
@@ -147,13 +354,385 @@ CInterpreter::tell() const {
     return 0;
   }
 
-  return gStream->tellg();
+  // positions handed out here come back through seek(), which needs to know
+  // which line they resume after to keep line numbers correct.
+
+  CStreamPos const position { gStream->tellg() };
+  mLineNos[position] = mLineNo;
+  return position;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::save(
+  std::ostream & stream
+) const {
+  auto const write_string = [&stream] (std::string_view const text) {
+    WriteRaw(stream, uint32_t(text.size()));
+    stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+  };
+
+  WriteRaw(stream, std::streamoff(tell()));
+  WriteRaw(stream, uint64_t(mLineNo));
+  write_string(mRegion);
+
+  WriteRaw(stream, uint32_t(mLabels.size()));
+
+  for (auto const & [label, position] : mLabels) {
+    write_string(label);
+    WriteRaw(stream, std::streamoff(position));
+  }
+
+  WriteRaw(stream, uint32_t(mLineNos.size()));
+
+  for (auto const & [position, line] : mLineNos) {
+    WriteRaw(stream, position);
+    WriteRaw(stream, uint64_t(line));
+  }
+
+  auto const write_params = [&] (CParams const & params) {
+    WriteRaw(stream, uint32_t(params.size()));
+
+    for (auto const & [name, value] : params) {
+      write_string(name);
+      write_string(value);
+    }
+  };
+
+  WriteRaw(stream, uint32_t(mMacros.size()));
+
+  for (auto const & [name, macro] : mMacros) {
+    write_string(name);
+    WriteRaw(stream, std::streamoff(macro.body));
+    write_params(macro.params);
+  }
+
+  WriteRaw(stream, uint32_t(mFrames.size()));
+
+  for (CFrame const & frame : mFrames) {
+    WriteRaw(stream, std::streamoff(frame.body));
+    WriteRaw(stream, std::streamoff(frame.resume));
+    WriteRaw(stream, frame.remaining);
+    WriteRaw(stream, uint8_t(frame.macro));
+    write_params(frame.args);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::load(
+  std::istream & stream
+) {
+  auto const read_string = [&stream] (std::string & text) {
+    uint32_t size { 0 };
+
+    if (!ReadRaw(stream, size)) {
+      return false;
+    }
+
+    text.resize(size);
+    return !!stream.read(text.data(), size);
+  };
+
+  std::streamoff position { 0 };
+  uint64_t line { 0 };
+  std::string region;
+
+  if (
+    !ReadRaw(stream, position) ||
+    !ReadRaw(stream, line) ||
+    !read_string(region)
+  ) {
+    return false;
+  }
+
+  uint32_t count { 0 };
+  std::map<std::string, CStreamPos> labels;
+  std::map<std::streamoff, std::string> labels_by_pos;
+
+  if (!ReadRaw(stream, count)) {
+    return false;
+  }
+
+  for (uint32_t i { 0 }; i < count; ++i) {
+    std::string label;
+    std::streamoff label_position { 0 };
+
+    if (!read_string(label) || !ReadRaw(stream, label_position)) {
+      return false;
+    }
+
+    labels_by_pos[label_position] = label;
+    labels[std::move(label)] = label_position;
+  }
+
+  std::map<std::streamoff, size_t> line_nos;
+
+  if (!ReadRaw(stream, count)) {
+    return false;
+  }
+
+  for (uint32_t i { 0 }; i < count; ++i) {
+    std::streamoff line_position { 0 };
+    uint64_t line_no { 0 };
+
+    if (!ReadRaw(stream, line_position) || !ReadRaw(stream, line_no)) {
+      return false;
+    }
+
+    line_nos[line_position] = size_t(line_no);
+  }
+
+  auto const read_params = [&] (CParams & params) {
+    uint32_t size { 0 };
+
+    if (!ReadRaw(stream, size)) {
+      return false;
+    }
+
+    params.resize(size);
+
+    for (auto & [name, value] : params) {
+      if (!read_string(name) || !read_string(value)) {
+        return false;
+      }
+    }
+
+    return true;
+  };
+
+  std::map<std::string, CMacro, std::less<>> macros;
+
+  if (!ReadRaw(stream, count)) {
+    return false;
+  }
+
+  for (uint32_t i { 0 }; i < count; ++i) {
+    std::string name;
+    std::streamoff body { 0 };
+    CParams params;
+
+    if (
+      !read_string(name) ||
+      !ReadRaw(stream, body) ||
+      !read_params(params)
+    ) {
+      return false;
+    }
+
+    macros[std::move(name)] = { body, std::move(params) };
+  }
+
+  std::vector<CFrame> frames;
+
+  if (!ReadRaw(stream, count)) {
+    return false;
+  }
+
+  for (uint32_t i { 0 }; i < count; ++i) {
+    std::streamoff body { 0 };
+    std::streamoff resume { 0 };
+    CFrame frame;
+    uint8_t macro { 0 };
+
+    if (
+      !ReadRaw(stream, body) ||
+      !ReadRaw(stream, resume) ||
+      !ReadRaw(stream, frame.remaining) ||
+      !ReadRaw(stream, macro) ||
+      !read_params(frame.args)
+    ) {
+      return false;
+    }
+
+    frame.body = body;
+    frame.resume = resume;
+    frame.macro = (macro != 0);
+    frames.push_back(std::move(frame));
+  }
+
+  mLabels = std::move(labels);
+  mLabelsByPos = std::move(labels_by_pos);
+  mLineNos = std::move(line_nos);
+  mMacros = std::move(macros);
+  mFrames = std::move(frames);
+  mLabel.clear();
+  mBranchAhead = false;
+  mSkipDepth = 0;
+  mExitCode = std::nullopt;
+
+  if (gStream != nullptr) {
+    gStream->clear();
+    gStream->seekg(position);
+  }
+
+  mLineNo = size_t(line);
+  mRegion = std::move(region);
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::optional<CInterpreter::CStreamPos>
+CInterpreter::target() const {
+  auto const it = mLabels.find(mLabel);
+
+  if (it == mLabels.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string_view
+CInterpreter::regionAt(
+  CStreamPos const position
+) const {
+  auto const it = mLabelsByPos.upper_bound(position);
+
+  if (it == mLabelsByPos.begin()) {
+    return { };
+  }
+
+  return std::prev(it)->second;
 }
 
 // -------------------------------------------------------------------------- //
 
 void CInterpreter::error() {
-  std::cerr << "ERROR on line " << mLineNo << ":" << std::endl;
+  std::cerr << "ERROR on line " << where(mLineNo) << ":" << std::endl;
+}
+
+// -------------------------------------------------------------------------- //
+
+CSourceMap & CInterpreter::sources() {
+  return mSources;
+}
+
+// -------------------------------------------------------------------------- //
+
+CSourceMap const & CInterpreter::sources() const {
+  return mSources;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string CInterpreter::where(
+  size_t const line
+) const {
+  return mSources.describe(line);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::limit(
+  std::optional<uint64_t> const max_instructions,
+  std::optional<std::chrono::milliseconds> const timeout
+) {
+  mMaxInstructions = max_instructions;
+  mTimeout = timeout;
+  restart();
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::restart() {
+  mExecuted = 0;
+  mYieldAt = UINT64_MAX;
+  mHalt = EHALT_NONE;
+
+  if (mTimeout != std::nullopt) {
+    mDeadline = (CClock::now() + *mTimeout);
+  }
+
+  mCheckpoint = (
+    (mMaxInstructions != std::nullopt || mTimeout != std::nullopt) ?
+      0 : UINT64_MAX
+  );
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::checkLimits() {
+  if (mMaxInstructions != std::nullopt && mExecuted >= *mMaxInstructions) {
+    mHalt = EHALT_INSTRUCTIONS;
+    return;
+  }
+
+  if (mTimeout != std::nullopt && CClock::now() >= mDeadline) {
+    mHalt = EHALT_TIMEOUT;
+    return;
+  }
+
+  if (mExecuted >= mYieldAt) {
+    mHalt = EHALT_YIELD;
+    return;
+  }
+
+  mCheckpoint = (
+    mTimeout != std::nullopt ? (mExecuted + CLOCK_PERIOD) : mYieldAt
+  );
+
+  if (mMaxInstructions != std::nullopt) {
+    mCheckpoint = std::min(mCheckpoint, *mMaxInstructions);
+  }
+
+  mCheckpoint = std::min(mCheckpoint, mYieldAt);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::fault() {
+  uint32_t const dar { gPPC->mfspr(ESPR_DAR) };
+  uint32_t const dsisr { gPPC->mfspr(ESPR_DSISR) };
+  std::string_view operation { mLine };
+
+  operation.remove_prefix(
+    std::min(operation.find_first_not_of(" \t"), operation.size())
+  );
+
+  error();
+  std::cerr << "DSI exception: ";
+  std::cerr << ((dsisr & EDSISR_STORE) ? "store to" : "load from");
+  std::cerr << " unmapped address 0x" << std::hex << std::setfill('0');
+  std::cerr << std::setw(8) << dar << std::dec << std::setfill(' ');
+  std::cerr << " in '" << operation << "'" << std::endl;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::exit(
+  int32_t const code
+) {
+  mExitCode = code;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::optional<int32_t> CInterpreter::exitCode() const {
+  return mExitCode;
+}
+
+// -------------------------------------------------------------------------- //
+
+int32_t CInterpreter::status() const {
+  if (gPPC != nullptr && gPPC->faulted()) {
+    return 1;
+  }
+
+  switch (mHalt) {
+    case EHALT_INSTRUCTIONS: {
+      return 125;
+    }
+    case EHALT_TIMEOUT: {
+      return 124;
+    }
+    default: {
+      return mExitCode.value_or(0);
+    }
+  }
 }
 
 // -------------------------------------------------------------------------- //
@@ -184,6 +763,24 @@ bool CInterpreter::skipSpace() {
 
 // -------------------------------------------------------------------------- //
 
+bool CInterpreter::expect(
+  char const c
+) {
+  skipSpace();
+
+  if (mCursor.empty() || mCursor[0] != c) {
+    error();
+    std::cerr << "expected '" << c << "'" << std::endl;
+    return false;
+  }
+
+  skip(1);
+  skipSpace();
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
 std::string_view
 CInterpreter::readWord() {
   size_t count { 0 };
@@ -271,7 +868,9 @@ CInterpreter::readInt(
     base = 10;
   }
 
-  int32_t value { 0 };
+  // accumulate unsigned so that full 32-bit addresses wrap instead of
+  // overflowing a signed value
+  uint32_t value { 0 };
   size_t digits { 0 };
 
   while (!mCursor.empty()) {
@@ -289,7 +888,7 @@ CInterpreter::readInt(
       break;
     }
 
-    value = (value * base + digit);
+    value = (value * uint32_t(base) + uint32_t(digit));
     ++digits;
     skip(1);
   }
@@ -299,9 +898,36 @@ CInterpreter::readInt(
   }
 
   if (negative) {
-    value = -value;
+    value = (0 - value);
+  }
+
+  return static_cast<int32_t>(value);
+}
+
+// -------------------------------------------------------------------------- //
+
+std::optional<double>
+CInterpreter::readFloat() {
+  if (mCursor.empty()) {
+    return std::nullopt;
+  }
+
+  // from_chars does not accept a leading '+'
+  if (mCursor[0] == '+') {
+    skip(1);
+  }
+
+  double value { 0.0 };
+
+  auto const result = std::from_chars(
+    mCursor.data(), (mCursor.data() + mCursor.size()), value
+  );
+
+  if (result.ec != std::errc { }) {
+    return std::nullopt;
   }
 
+  skip(size_t(result.ptr - mCursor.data()));
   return value;
 }
 
@@ -401,6 +1027,295 @@ CInterpreter::readString(
 
 // -------------------------------------------------------------------------- //
 
+CEcho const *
+CInterpreter::echo() {
+  // each expansion may substitute a different format into the line
+  if (mSubstituted) {
+    std::optional<std::string> const format { readString() };
+
+    if (format == std::nullopt) {
+      return nullptr;
+    }
+
+    mExpandedEcho = CEcho::Compile(*format);
+    return (mExpandedEcho != std::nullopt ? &*mExpandedEcho : nullptr);
+  }
+
+  auto it = mEchoes.find(mLineNo);
+
+  if (it == mEchoes.end()) {
+    std::optional<std::string> const format { readString() };
+
+    if (format == std::nullopt) {
+      return nullptr;
+    }
+
+    std::optional<CEcho> echo { CEcho::Compile(*format) };
+
+    if (echo == std::nullopt) {
+      return nullptr;
+    }
+
+    it = mEchoes.emplace(mLineNo, std::move(*echo)).first;
+  }
+
+  return &it->second;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::macro() {
+  skipSpace();
+  std::string const name { readWord() };
+
+  if (
+    name.empty() || name[0] == '.' ||
+    CInstruction::Fetch(name) != nullptr
+  ) {
+    error();
+    std::cerr << "bad macro name." << std::endl;
+    return false;
+  }
+
+  CMacro definition;
+
+  for (std::string_view const operand : SplitOperands(mCursor)) {
+    size_t const equals { operand.find('=') };
+    std::string_view param { operand.substr(0, equals) };
+    std::string_view value;
+
+    // PARAM=DEFAULT
+    if (equals != std::string_view::npos) {
+      param = param.substr(0, (param.find_last_not_of(' ') + 1));
+      value = operand.substr(equals + 1);
+      value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+    }
+
+    if (param.empty() || !std::all_of(param.begin(), param.end(), IsNameChar)) {
+      error();
+      std::cerr << "bad macro parameter." << std::endl;
+      return false;
+    }
+
+    definition.params.emplace_back(param, value);
+  }
+
+  // the body is skipped here and replayed from its first line when invoked
+  definition.body = tell();
+  mMacros[name] = std::move(definition);
+  mSkipDepth = 1;
+  mSkipOpen = ".macro";
+  mSkipClose = ".endm";
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::endMacro() {
+  // repetitions the body was left through end with it
+  while (!mFrames.empty() && !mFrames.back().macro) {
+    mFrames.pop_back();
+  }
+
+  if (mFrames.empty()) {
+    error();
+    std::cerr << ".endm outside a macro." << std::endl;
+    return false;
+  }
+
+  CStreamPos const resume { mFrames.back().resume };
+  mFrames.pop_back();
+  gStream->seekg(resume);
+  mLineNo = mLineNos[resume];
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::repeat() {
+  skipSpace();
+  std::optional<int32_t> const count { readInt() };
+
+  if (count == std::nullopt || *count < 0) {
+    error();
+    std::cerr << "bad repeat count." << std::endl;
+    return false;
+  }
+
+  if (*count == 0) {
+    mSkipDepth = 1;
+    mSkipOpen = ".rept";
+    mSkipClose = ".endr";
+    return true;
+  }
+
+  CFrame frame;
+  frame.body = tell();
+  frame.remaining = uint32_t(*count - 1);
+
+  enter(frame.body);
+  mFrames.push_back(std::move(frame));
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::endRepeat() {
+  if (mFrames.empty() || mFrames.back().macro) {
+    error();
+    std::cerr << ".endr without .rept." << std::endl;
+    return false;
+  }
+
+  CFrame & frame { mFrames.back() };
+
+  if (frame.remaining == 0) {
+    mFrames.pop_back();
+    return true;
+  }
+
+  --frame.remaining;
+  gStream->seekg(frame.body);
+  mLineNo = mLineNos[frame.body];
+
+  // a repetition is a loop as far as the limits are concerned
+  if (mExecuted >= mCheckpoint) {
+    checkLimits();
+  }
+
+  return (mHalt == EHALT_NONE);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::substitute(
+  std::string_view const line
+) {
+  auto const frame = std::find_if(
+    mFrames.rbegin(), mFrames.rend(),
+    [] (CFrame const & frame) { return frame.macro; }
+  );
+
+  if (frame == mFrames.rend()) {
+    return;
+  }
+
+  mExpanded.clear();
+
+  for (size_t i { 0 }; i < line.size(); ) {
+    if (line[i] != '\\') {
+      mExpanded += line[i++];
+      continue;
+    }
+
+    // \() ends a parameter name that is followed by more name characters
+    if (line.compare((i + 1), 2, "()") == 0) {
+      i += 3;
+      continue;
+    }
+
+    size_t end { i + 1 };
+
+    while (end < line.size() && IsNameChar(line[end])) {
+      ++end;
+    }
+
+    std::string_view const name { line.substr((i + 1), (end - i - 1)) };
+
+    auto const arg = std::find_if(
+      frame->args.begin(), frame->args.end(),
+      [name] (auto const & arg) { return (arg.first == name); }
+    );
+
+    if (name.empty() || arg == frame->args.end()) {
+      mExpanded += line.substr(i, std::max<size_t>((end - i), 1));
+      i = std::max((i + 1), end);
+    } else {
+      mExpanded += arg->second;
+      i = end;
+    }
+  }
+
+  mLine = mExpanded;
+  mSubstituted = true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::invoke(
+  CMacro const & macro
+) {
+  std::vector<std::string_view> const operands { SplitOperands(mCursor) };
+
+  if (operands.size() > macro.params.size()) {
+    error();
+    std::cerr << "too many macro arguments." << std::endl;
+    return false;
+  }
+
+  CFrame frame;
+  frame.body = macro.body;
+  frame.resume = tell();
+  frame.macro = true;
+  frame.args = macro.params;
+
+  for (size_t i { 0 }; i < operands.size(); ++i) {
+    if (!operands[i].empty()) {
+      frame.args[i].second = operands[i];
+    }
+  }
+
+  enter(frame.body);
+  mFrames.push_back(std::move(frame));
+  gStream->seekg(macro.body);
+  mLineNo = mLineNos[macro.body];
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CInterpreter::skipAhead(
+  std::string_view const key
+) {
+  // definitions are recorded like labels, even where they are not run
+  if (key == ".macro") {
+    return macro();
+  }
+
+  if (key == ".rept") {
+    ++mSkippedRepeats;
+  } else if (key == ".endr") {
+    if (mSkippedRepeats != 0) {
+      --mSkippedRepeats;
+    } else if (!mFrames.empty() && !mFrames.back().macro) {
+      // the branch leaves the body: no more repetitions
+      mFrames.pop_back();
+    }
+  } else if (key == ".endm") {
+    // the search continues after the invocation
+    return endMacro();
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CInterpreter::enter(
+  CStreamPos const body
+) {
+  // a body entered again, by a branch back over it or by recursion, was
+  // left without reaching its end; so were the bodies entered from it
+  auto const it = std::find_if(
+    mFrames.begin(), mFrames.end(),
+    [body] (CFrame const & frame) { return (frame.body == body); }
+  );
+
+  mFrames.erase(it, mFrames.end());
+}
+
+// -------------------------------------------------------------------------- //
+
 bool CInterpreter::readArg(
   std::string_view signature,
   bool const silent
@@ -564,6 +1479,15 @@ bool CInterpreter::readArg(
         std::cerr << "bad argument '" << name << "'" << std::endl;
       }
 
+      return false;
+    }
+  } else if (type == "spr") {
+    if (!CProcessor::IsSPR(size_t(value))) {
+      if (!silent) {
+        error();
+        std::cerr << "bad argument '" << name << "'" << std::endl;
+      }
+
       return false;
     }
   } else if (type == "bit") {
@@ -577,6 +1501,7 @@ bool CInterpreter::readArg(
     }
   }
 
+  mArgNames[mArgNo] = name;
   mArgs[mArgNo++] = value;
   return true;
 }
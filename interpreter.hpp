@@ -6,54 +6,236 @@
 
 // -------------------------------------------------------------------------- //
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
+#include <istream>
 #include <map>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "echo.hpp"
+#include "linker.hpp"
 #include "processor.hpp"
 
 // -------------------------------------------------------------------------- //
 
+enum EHalt : uint8_t {
+
+  EHALT_NONE,
+  EHALT_INSTRUCTIONS, // the instruction limit was reached
+  EHALT_TIMEOUT,      // the wall-clock limit elapsed
+  EHALT_YIELD,        // the budget of run() ran out (never seen by callers)
+
+};
+
+enum ERun : uint8_t {
+
+  ERUN_STOPPED, // the program ended: see exitCode(), halted() and status()
+  ERUN_YIELDED, // the budget ran out at a taken branch; run() resumes
+
+};
+
+// -------------------------------------------------------------------------- //
+
 class CInterpreter {
 
   public:
 
-  using CStreamPos = std::ifstream::pos_type;
+  using CStreamPos = std::istream::pos_type;
+  using CClock = std::chrono::steady_clock;
+
+  // the clock is read at most once per this many operations
+  static uint64_t const CLOCK_PERIOD { 65536 };
 
   bool interpret();
 
+  // interprets until the program stops or, given a budget, until at least
+  // that many operations have run and a branch is taken. all state stays in
+  // the interpreter and the processor, so many programs can be multiplexed
+  // by pointing gPPC, gInterpreter and gStream at one before each call.
+  ERun run(std::optional<uint64_t> budget = std::nullopt);
+
   void branch();
 
+  // takes a branch to the pending label or, if given, a saved position
+  void jump(std::optional<uint32_t> target);
+
   void seek(CStreamPos position);
   CStreamPos tell() const;
 
+  // position of the pending branch target, if its label has been seen
+  std::optional<CStreamPos> target() const;
+
+  // name of the label whose code contains the given position
+  std::string_view regionAt(CStreamPos position) const;
+
   inline std::string_view cursor() const {
     return mCursor;
   }
 
+  inline size_t line() const {
+    return mLineNo;
+  }
+
+  // name of the pending branch target
+  inline std::string_view label() const {
+    return mLabel;
+  }
+
+  // true while lines are skipped in search of a forward branch target or
+  // the end of a macro definition
+  inline bool skipping() const {
+    return (mBranchAhead || mSkipDepth != 0);
+  }
+
+  // name of the label whose code is currently executing
+  inline std::string_view region() const {
+    return mRegion;
+  }
+
   void error();
 
+  // origins of the program's lines when it was linked from several files;
+  // line() stays the line of the linked program
+  CSourceMap & sources();
+  CSourceMap const & sources() const;
+
+  // line of the linked program as reported to the user
+  std::string where(size_t line) const;
+
+  // limits are only checked at taken branches, which any runaway program has
+  // to keep passing, so a program stops at the first taken branch past them
+  void limit(
+    std::optional<uint64_t> max_instructions,
+    std::optional<std::chrono::milliseconds> timeout
+  );
+
+  // restarts the operation count and the timeout
+  void restart();
+
+  inline EHalt halted() const {
+    return mHalt;
+  }
+
+  inline uint64_t executed() const {
+    return mExecuted;
+  }
+
+  // set by .exit; stays empty when the program stops on an error
+  void exit(int32_t code);
+  std::optional<int32_t> exitCode() const;
+
+  // the ippc exit status for how the program stopped: the .exit code, 1 on a
+  // DSI, 125 or 124 when stopped by the instruction or time limit, else 0
+  int32_t status() const;
+
   bool skip(size_t);
   bool skipSpace();
 
+  bool expect(char c);
+
   std::string_view readWord();
   std::optional<int32_t> readInt(int8_t base = -1);
+  std::optional<double> readFloat();
   std::optional<std::string> readString(bool silent = false);
 
+  // compiled format of the .echo on the current line, compiled on first use
+  CEcho const * echo();
+
+  // .macro NAME [PARAM[=DEFAULT], ...] records the lines up to .endm, which
+  // then run in place of any line whose operation is NAME, with \PARAM (or
+  // \PARAM\() before other text) replaced by the matching operand. .rept N
+  // runs the lines up to .endr N times. bodies are replayed from the program
+  // rather than copied, so lines without parameters read and cache the same
+  // way in every repetition. a body may be left at its end, by a forward
+  // branch or by a call that returns into it.
+  bool macro();
+  bool endMacro();
+  bool repeat();
+  bool endRepeat();
+
+  // the position after the current line, the labels and macros seen so far,
+  // the expansions in progress and the line numbers of saved positions
+  void save(std::ostream & stream) const;
+  bool load(std::istream & stream);
+
   private:
 
+  using CParams = std::vector<std::pair<std::string, std::string>>;
+
+  struct CMacro {
+
+    CStreamPos body;
+    CParams params; // names and defaults
+
+  };
+
+  // an expansion in progress: a macro invocation or a .rept
+  struct CFrame {
+
+    CStreamPos body;
+    CStreamPos resume;        // line after the invocation (macros)
+    uint32_t remaining { 0 }; // repetitions after this one (.rept)
+    bool macro { false };
+    CParams args;             // parameter names and operands (macros)
+
+  };
+
   std::map<std::string, CStreamPos> mLabels;
+  std::map<std::streamoff, std::string> mLabelsByPos;
+  mutable std::map<std::streamoff, size_t> mLineNos;
   std::string_view mLine;
   std::string_view mCursor;
   size_t mLineNo { 0 };
   int32_t mArgs[8];
+  std::string_view mArgNames[8];
   size_t mArgNo { 0 };
   std::string mLabel;
   bool mBranchAhead { false };
+  size_t mBranchSite { 0 };
+  std::string mRegion;
+  std::unordered_map<size_t, CEcho> mEchoes;
+  std::optional<int32_t> mExitCode;
+  uint64_t mExecuted { 0 };
+  uint64_t mCheckpoint { UINT64_MAX };
+  uint64_t mYieldAt { UINT64_MAX };
+  std::optional<uint64_t> mMaxInstructions;
+  std::optional<std::chrono::milliseconds> mTimeout;
+  CClock::time_point mDeadline;
+  EHalt mHalt { EHALT_NONE };
+  CSourceMap mSources;
+  std::map<std::string, CMacro, std::less<>> mMacros;
+  std::vector<CFrame> mFrames;
+  std::string mExpanded;
+  bool mSubstituted { false };
+  std::optional<CEcho> mExpandedEcho;
+  size_t mSkipDepth { 0 };      // nesting within a body that is not run
+  std::string_view mSkipOpen;
+  std::string_view mSkipClose;
+  size_t mSkippedRepeats { 0 }; // .rept bodies entered by a forward search
+
+  // reports the DSI raised by the current operation
+  void fault();
+
+  void checkLimits();
+
+  // replaces the parameters of the innermost macro in the current line
+  void substitute(std::string_view line);
+
+  bool invoke(CMacro const & macro);
+
+  // how a forward search treats the lines that open and close bodies
+  bool skipAhead(std::string_view key);
+
+  // drops any expansion of body still in progress, along with those it
+  // started, before body is entered again
+  void enter(CStreamPos body);
 
   bool readArg(
     std::string_view signature,
@@ -69,7 +251,7 @@ class CInterpreter {
 
 // -------------------------------------------------------------------------- //
 
-extern std::ifstream * gStream;
+extern std::istream * gStream;
 extern CInterpreter * gInterpreter;
 
 // -------------------------------------------------------------------------- //
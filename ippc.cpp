@@ -0,0 +1,301 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// embedding API
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "interpreter.hpp"
+#include "ippc.h"
+#include "linker.hpp"
+#include "output.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+struct ippc_machine {
+
+  explicit ippc_machine(size_t const memory_size) :
+    processor { memory_size },
+    output { text }
+  { }
+
+  CProcessor processor;
+  CInterpreter interpreter;
+  std::istringstream stream;
+  std::string text;
+  COutput output;
+
+};
+
+// -------------------------------------------------------------------------- //
+
+static void Activate(
+  ippc_machine * const machine
+) {
+  gPPC = &machine->processor;
+  gInterpreter = &machine->interpreter;
+  gStream = &machine->stream;
+  gOutput = &machine->output;
+}
+
+// -------------------------------------------------------------------------- //
+
+ippc_machine * ippc_create(
+  size_t const memory_size
+) {
+  return new ippc_machine {
+    (memory_size != 0 ? memory_size : (24 * 1024 * 1024))
+  };
+}
+
+// -------------------------------------------------------------------------- //
+
+void ippc_destroy(
+  ippc_machine * const machine
+) {
+  if (machine == nullptr) {
+    return;
+  }
+
+  // leave no dangling globals behind for the next machine
+  if (gPPC == &machine->processor) {
+    gPPC = nullptr;
+    gInterpreter = nullptr;
+    gStream = nullptr;
+    gOutput = nullptr;
+  }
+
+  delete machine;
+}
+
+// -------------------------------------------------------------------------- //
+
+int ippc_load(
+  ippc_machine * const machine,
+  char const * const source,
+  size_t const size
+) {
+  CSourceMap sources;
+  std::optional<std::string> program {
+    CLinker::Link(std::string_view { source, size }, ".", &sources)
+  };
+
+  if (program == std::nullopt) {
+    return 0;
+  }
+
+  machine->stream.clear();
+  machine->stream.str(std::move(*program));
+  machine->interpreter = CInterpreter { };
+  machine->interpreter.sources() = std::move(sources);
+  machine->processor.clearFault();
+  ippc_clear_output(machine);
+  return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+void ippc_reset(
+  ippc_machine * const machine
+) {
+  machine->processor.reset();
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t ippc_get_gpr(
+  ippc_machine const * const machine,
+  unsigned const n
+) {
+  return machine->processor.gpr(n % 32).u32();
+}
+
+// -------------------------------------------------------------------------- //
+
+void ippc_set_gpr(
+  ippc_machine * const machine,
+  unsigned const n,
+  uint32_t const value
+) {
+  machine->processor.gpr(n % 32) = CGPR { value };
+}
+
+// -------------------------------------------------------------------------- //
+
+double ippc_get_fpr(
+  ippc_machine const * const machine,
+  unsigned const n
+) {
+  return machine->processor.fpr(n % 32).f64();
+}
+
+// -------------------------------------------------------------------------- //
+
+void ippc_set_fpr(
+  ippc_machine * const machine,
+  unsigned const n,
+  double const value
+) {
+  machine->processor.fpr(n % 32) = CFPR { value };
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t ippc_get_cr(
+  ippc_machine const * const machine,
+  unsigned const n
+) {
+  return machine->processor.cr(n % 8);
+}
+
+// -------------------------------------------------------------------------- //
+
+void ippc_set_cr(
+  ippc_machine * const machine,
+  unsigned const n,
+  uint8_t const value
+) {
+  machine->processor.cr(n % 8) = (value & 0xF);
+}
+
+// -------------------------------------------------------------------------- //
+
+int ippc_get_spr(
+  ippc_machine const * const machine,
+  unsigned const spr,
+  uint32_t * const value
+) {
+  if (!CProcessor::IsSPR(spr)) {
+    return 0;
+  }
+
+  *value = machine->processor.mfspr(spr);
+  return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+int ippc_set_spr(
+  ippc_machine * const machine,
+  unsigned const spr,
+  uint32_t const value
+) {
+  if (!CProcessor::IsSPR(spr)) {
+    return 0;
+  }
+
+  machine->processor.mtspr(spr, value);
+  return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+int ippc_read(
+  ippc_machine const * const machine,
+  uint32_t const addr,
+  void * const data,
+  size_t const size
+) {
+  uint8_t const * const memory {
+    std::as_const(machine->processor).host(addr, size)
+  };
+
+  if (memory == nullptr) {
+    return 0;
+  }
+
+  std::memcpy(data, memory, size);
+  return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+int ippc_write(
+  ippc_machine * const machine,
+  uint32_t const addr,
+  void const * const data,
+  size_t const size
+) {
+  uint8_t * const memory { machine->processor.host(addr, size) };
+
+  if (memory == nullptr) {
+    return 0;
+  }
+
+  std::memcpy(memory, data, size);
+  return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+ippc_status ippc_run(
+  ippc_machine * const machine,
+  uint64_t const budget
+) {
+  Activate(machine);
+
+  ERun const result {
+    machine->interpreter.run(
+      budget != 0 ? std::optional<uint64_t> { budget } : std::nullopt
+    )
+  };
+
+  if (result == ERUN_YIELDED) {
+    return IPPC_BUDGET;
+  }
+
+  if (machine->processor.faulted()) {
+    return IPPC_FAULT;
+  }
+
+  return IPPC_STOPPED;
+}
+
+// -------------------------------------------------------------------------- //
+
+int ippc_exit_code(
+  ippc_machine const * const machine,
+  int32_t * const code
+) {
+  std::optional<int32_t> const exit_code { machine->interpreter.exitCode() };
+
+  if (exit_code == std::nullopt) {
+    return 0;
+  }
+
+  *code = *exit_code;
+  return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+char const * ippc_output(
+  ippc_machine * const machine,
+  size_t * const size
+) {
+  machine->output.flush();
+  *size = machine->text.size();
+  return machine->text.data();
+}
+
+// -------------------------------------------------------------------------- //
+
+void ippc_clear_output(
+  ippc_machine * const machine
+) {
+  machine->output.flush();
+  machine->text.clear();
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
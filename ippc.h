@@ -0,0 +1,120 @@
+/* ========================================================================== */
+
+#ifndef INCLUDE_IPPC_H
+#define INCLUDE_IPPC_H
+
+/* -------------------------------------------------------------------------- */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+
+#if defined(_WIN32) && defined(IPPC_SHARED)
+  #ifdef IPPC_BUILD
+    #define IPPC_API __declspec(dllexport)
+  #else
+    #define IPPC_API __declspec(dllimport)
+  #endif
+#elif defined(IPPC_SHARED)
+  #define IPPC_API __attribute__((visibility("default")))
+#else
+  #define IPPC_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+/* embedding API for running programs in-process. a machine owns the emulated
+   processor, the program and its output. the interpreter state is global, so
+   machines may be used from one thread at a time only; ippc_run switches the
+   process to the machine it is given. */
+
+typedef struct ippc_machine ippc_machine;
+
+typedef enum ippc_status {
+
+  IPPC_STOPPED = 0, /* ran off the end, .exit or an error (see stderr) */
+  IPPC_BUDGET  = 1, /* budget used up at a taken branch; run again to resume */
+  IPPC_FAULT   = 2, /* DSI on an unmapped address */
+
+} ippc_status;
+
+/* memory_size 0 selects the default of 24 MiB */
+IPPC_API ippc_machine * ippc_create(size_t memory_size);
+IPPC_API void ippc_destroy(ippc_machine * machine);
+
+/* replaces the program and starts it from its first line; labels, output,
+   the exit code and a fault are cleared, registers and memory are kept.
+   .include paths resolve against the working directory. returns 0, keeping
+   the previous program, if an include fails (see stderr). */
+IPPC_API int ippc_load(
+  ippc_machine * machine,
+  char const * source,
+  size_t size
+);
+
+/* returns memory and registers to the power-on state and clears a fault */
+IPPC_API void ippc_reset(ippc_machine * machine);
+
+IPPC_API uint32_t ippc_get_gpr(ippc_machine const * machine, unsigned n);
+IPPC_API void ippc_set_gpr(ippc_machine * machine, unsigned n, uint32_t value);
+
+IPPC_API double ippc_get_fpr(ippc_machine const * machine, unsigned n);
+IPPC_API void ippc_set_fpr(ippc_machine * machine, unsigned n, double value);
+
+/* ECR flags of field n */
+IPPC_API uint8_t ippc_get_cr(ippc_machine const * machine, unsigned n);
+IPPC_API void ippc_set_cr(ippc_machine * machine, unsigned n, uint8_t value);
+
+/* special-purpose registers by number (XER 1, LR 8, CTR 9, GQRn 912+n, ...);
+   these return 0 if spr is not supported */
+IPPC_API int ippc_get_spr(
+  ippc_machine const * machine,
+  unsigned spr,
+  uint32_t * value
+);
+
+IPPC_API int ippc_set_spr(ippc_machine * machine, unsigned spr, uint32_t value);
+
+/* copies between host and emulated memory; these return 0 if the range is
+   not entirely mapped */
+IPPC_API int ippc_read(
+  ippc_machine const * machine,
+  uint32_t addr,
+  void * data,
+  size_t size
+);
+
+IPPC_API int ippc_write(
+  ippc_machine * machine,
+  uint32_t addr,
+  void const * data,
+  size_t size
+);
+
+/* runs until the program stops or, if budget is not 0, about budget
+   operations have executed */
+IPPC_API ippc_status ippc_run(ippc_machine * machine, uint64_t budget);
+
+/* returns 0 unless the program stopped at .exit */
+IPPC_API int ippc_exit_code(ippc_machine const * machine, int32_t * code);
+
+/* output written by .echo and friends since the last ippc_clear_output; the
+   text is not NUL-terminated and stays valid until the next call on machine */
+IPPC_API char const * ippc_output(ippc_machine * machine, size_t * size);
+
+IPPC_API void ippc_clear_output(ippc_machine * machine);
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+/* ========================================================================== */
+
+#endif
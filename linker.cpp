@@ -0,0 +1,501 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// .include linker
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "instruction.hpp"
+#include "linker.hpp"
+
+// -------------------------------------------------------------------------- //
+
+struct CModule {
+
+  std::filesystem::file_time_type time;
+  std::string path; // canonical, the key in sModules
+  std::string name;
+  std::string text;
+
+};
+
+// a source line split the way the interpreter reads it
+struct CLine {
+
+  std::string_view indent;
+  std::string_view key;   // first word
+  std::string_view rest;  // everything after it, comment removed
+  bool label { false };   // key is followed by ':'
+
+};
+
+// state of one Link
+struct CExpansion {
+
+  std::string program;
+  std::vector<std::string> stack;  // canonical paths being expanded
+  std::set<std::string> included;  // canonical paths spliced in so far
+  std::set<std::string> names;     // module names
+  CSourceMap sources;
+
+};
+
+static std::map<std::string, CModule> sModules;
+
+// -------------------------------------------------------------------------- //
+
+// calls visit with each line of text until it returns false
+template<typename F>
+static bool ForEachLine(
+  std::string_view const text,
+  F const & visit
+) {
+  for (size_t at { 0 }; at < text.size(); ) {
+    size_t const end { std::min(text.find('\n', at), text.size()) };
+
+    if (!visit(text.substr(at, (end - at)))) {
+      return false;
+    }
+
+    at = (end + 1);
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+static std::string_view Trim(
+  std::string_view text
+) {
+  size_t const first { text.find_first_not_of(" \t\r") };
+
+  if (first == std::string_view::npos) {
+    return { };
+  }
+
+  size_t const last { text.find_last_not_of(" \t\r") };
+  return text.substr(first, (last - first + 1));
+}
+
+// -------------------------------------------------------------------------- //
+
+static CLine Split(
+  std::string_view line
+) {
+  line = line.substr(0, line.find(';'));
+
+  CLine split;
+  size_t const start { std::min(line.find_first_not_of(" \t"), line.size()) };
+  size_t const end { std::min(line.find_first_of(" :", start), line.size()) };
+
+  split.indent = line.substr(0, start);
+  split.key = line.substr(start, (end - start));
+  split.rest = line.substr(end);
+
+  std::string_view const after { Trim(split.rest) };
+  split.label = (!split.key.empty() && !after.empty() && after[0] == ':');
+  return split;
+}
+
+// -------------------------------------------------------------------------- //
+
+// the label operand of a branch line, if any: the last operand of an
+// instruction whose signature ends in an address
+static std::optional<std::string_view> BranchTarget(
+  CLine const & line
+) {
+  if (line.label || line.key.empty() || line.key[0] == '.') {
+    return std::nullopt;
+  }
+
+  CInstruction const * const instruction { CInstruction::Fetch(line.key) };
+
+  if (
+    instruction == nullptr ||
+    instruction->signature.find(":addr}") == std::string_view::npos
+  ) {
+    return std::nullopt;
+  }
+
+  std::string_view operand { line.rest };
+  size_t const comma { operand.rfind(',') };
+
+  if (comma != std::string_view::npos) {
+    operand = operand.substr(comma + 1);
+  }
+
+  operand = Trim(operand);
+
+  if (operand.empty()) {
+    return std::nullopt;
+  }
+
+  return operand;
+}
+
+// -------------------------------------------------------------------------- //
+
+static std::optional<std::string> IncludePath(
+  CLine const & line
+) {
+  if (line.key != ".include") {
+    return std::nullopt;
+  }
+
+  std::string_view const rest { Trim(line.rest) };
+
+  if (rest.size() < 2 || rest.front() != '"' || rest.back() != '"') {
+    return std::string { };
+  }
+
+  return std::string { rest.substr(1, (rest.size() - 2)) };
+}
+
+// -------------------------------------------------------------------------- //
+
+// renames the labels a module defines, and its references to them, to
+// NAME.label; includes are left for Expand
+static std::string Rename(
+  std::string_view const text,
+  std::string_view const name
+) {
+  std::set<std::string_view> labels;
+
+  // labels built from macro parameters are left alone; they are told apart
+  // by their arguments
+  ForEachLine(text, [&labels] (std::string_view const text_line) {
+    CLine const line { Split(text_line) };
+
+    if (line.label && line.key.find('\\') == std::string_view::npos) {
+      labels.insert(line.key);
+    }
+
+    return true;
+  });
+
+  std::string renamed;
+  renamed.reserve(text.size() + (labels.size() * (name.size() + 1) * 4));
+
+  ForEachLine(text, [&] (std::string_view const text_line) {
+    CLine const line { Split(text_line) };
+    std::optional<std::string_view> const target { BranchTarget(line) };
+
+    renamed += line.indent;
+
+    if (line.label && labels.count(line.key) == 1) {
+      renamed.append(name).append(".").append(line.key);
+      renamed += line.rest;
+    } else if (target != std::nullopt && labels.count(*target) == 1) {
+      size_t const offset { size_t(target->data() - line.rest.data()) };
+
+      renamed += line.key;
+      renamed += line.rest.substr(0, offset);
+      renamed.append(name).append(".").append(*target);
+      renamed += line.rest.substr(offset + target->size());
+    } else {
+      renamed += line.key;
+      renamed += line.rest;
+    }
+
+    renamed += '\n';
+    return true;
+  });
+
+  return renamed;
+}
+
+// -------------------------------------------------------------------------- //
+
+static CModule const * Load(
+  std::filesystem::path const & path
+) {
+  // the non-throwing overloads, since a bad path must not escape as an
+  // exception through ippc_load or a server worker
+  std::error_code error;
+  std::filesystem::path const canonical {
+    std::filesystem::weakly_canonical(path, error)
+  };
+
+  if (error) {
+    return nullptr;
+  }
+
+  std::filesystem::file_time_type const time {
+    std::filesystem::last_write_time(canonical, error)
+  };
+
+  if (error) {
+    return nullptr;
+  }
+
+  auto const it = sModules.find(canonical.string());
+
+  if (it != sModules.end() && it->second.time == time) {
+    return &it->second;
+  }
+
+  std::ifstream file { canonical, std::ios::binary };
+
+  if (!file.is_open()) {
+    return nullptr;
+  }
+
+  std::string const text {
+    std::istreambuf_iterator<char> { file },
+    std::istreambuf_iterator<char> { }
+  };
+
+  CModule & module { sModules[canonical.string()] };
+  module.time = time;
+  module.path = canonical.string();
+  module.name = canonical.stem().string();
+  module.text = Rename(text, module.name);
+  return &module;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool Expand(
+  std::string_view const text,
+  std::filesystem::path const & directory,
+  size_t const file,
+  CExpansion & expansion
+) {
+  size_t line_no { 0 };
+
+  return ForEachLine(text, [&] (std::string_view const line) {
+    std::optional<std::string> const include { IncludePath(Split(line)) };
+    ++line_no;
+
+    if (include == std::nullopt) {
+      expansion.program.append(line).append("\n");
+      expansion.sources.add(file, line_no);
+      return true;
+    }
+
+    if (include->empty()) {
+      std::cerr << "expected string after .include." << std::endl;
+      return false;
+    }
+
+    std::filesystem::path const path { directory / *include };
+    CModule const * const module { Load(path) };
+
+    if (module == nullptr) {
+      std::cerr << "failed to include '" << *include << "'." << std::endl;
+      return false;
+    }
+
+    std::string const & key { module->path };
+    std::vector<std::string> & stack { expansion.stack };
+
+    if (std::find(stack.begin(), stack.end(), key) != stack.end()) {
+      std::cerr << "'" << *include << "' includes itself." << std::endl;
+      return false;
+    }
+
+    // a module shared by several includers is spliced in once
+    if (!expansion.included.insert(key).second) {
+      return true;
+    }
+
+    stack.push_back(key);
+    expansion.names.insert(module->name);
+
+    size_t const module_file {
+      expansion.sources.file(path.lexically_normal().generic_string())
+    };
+
+    bool const expanded {
+      Expand(module->text, path.parent_path(), module_file, expansion)
+    };
+
+    stack.pop_back();
+    return expanded;
+  });
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CSourceMap::file(
+  std::string_view const name
+) {
+  auto const it = std::find(mFiles.begin(), mFiles.end(), name);
+
+  if (it != mFiles.end()) {
+    return size_t(it - mFiles.begin());
+  }
+
+  mFiles.emplace_back(name);
+  return (mFiles.size() - 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CSourceMap::add(
+  size_t const file,
+  size_t const line
+) {
+  mLines.emplace_back(uint32_t(file), uint32_t(line));
+}
+
+// -------------------------------------------------------------------------- //
+
+void CSourceMap::truncate(
+  size_t const count
+) {
+  mLines.resize(std::min(count, mLines.size()));
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CSourceMap::size() const {
+  return mLines.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string_view CSourceMap::fileOf(
+  size_t const line
+) const {
+  if (line == 0 || line > mLines.size()) {
+    return { };
+  }
+
+  return mFiles[mLines[line - 1].first];
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CSourceMap::lineOf(
+  size_t const line
+) const {
+  if (line == 0 || line > mLines.size()) {
+    return line;
+  }
+
+  return mLines[line - 1].second;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string CSourceMap::describe(
+  size_t const line
+) const {
+  std::string text { std::to_string(lineOf(line)) };
+  std::string_view const file { fileOf(line) };
+
+  if (!file.empty()) {
+    text.append(" of ").append(file);
+  }
+
+  return text;
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CSourceMap::key(
+  size_t const line
+) const {
+  if (line == 0 || line > mLines.size()) {
+    return line;
+  }
+
+  return ((size_t(mLines[line - 1].first) << 20) ^ mLines[line - 1].second);
+}
+
+// -------------------------------------------------------------------------- //
+
+std::optional<std::string> CLinker::Link(
+  std::string_view const source,
+  std::filesystem::path const & directory,
+  CSourceMap * const sources
+) {
+  if (sources != nullptr) {
+    *sources = CSourceMap { };
+  }
+
+  // most programs include nothing; leave those untouched
+  if (source.find(".include") == std::string_view::npos) {
+    return std::string { source };
+  }
+
+  CExpansion expansion;
+
+  if (!Expand(source, directory, 0, expansion)) {
+    return std::nullopt;
+  }
+
+  std::string const & program { expansion.program };
+  std::set<std::string> const & names { expansion.names };
+
+  // branches into a module must name one of its labels
+  std::set<std::string_view> labels;
+
+  ForEachLine(program, [&labels] (std::string_view const text_line) {
+    CLine const line { Split(text_line) };
+
+    if (line.label) {
+      labels.insert(line.key);
+    }
+
+    return true;
+  });
+
+  bool const resolved {
+    ForEachLine(program, [&] (std::string_view const text_line) {
+      std::optional<std::string_view> const target {
+        BranchTarget(Split(text_line))
+      };
+
+      if (
+        target == std::nullopt || labels.count(*target) == 1 ||
+        target->find('\\') != std::string_view::npos
+      ) {
+        return true;
+      }
+
+      size_t const dot { target->find('.') };
+
+      if (
+        dot != std::string_view::npos &&
+        names.count(std::string { target->substr(0, dot) }) == 1
+      ) {
+        std::cerr << "undefined label '" << *target << "'." << std::endl;
+        return false;
+      }
+
+      return true;
+    })
+  };
+
+  if (!resolved) {
+    return std::nullopt;
+  }
+
+  if (sources != nullptr) {
+    *sources = std::move(expansion.sources);
+  }
+
+  return std::move(expansion.program);
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
@@ -0,0 +1,86 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_LINKER_HPP
+#define INCLUDE_LINKER_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// -------------------------------------------------------------------------- //
+
+// where each line of a linked program came from, so that diagnostics and
+// reports name the line of the file a user can open. a map with no lines
+// recorded leaves every line as it is, which is the case for programs that
+// include nothing.
+
+class CSourceMap {
+
+  public:
+
+  // index of a file for add(); the input itself is "" and always 0
+  size_t file(std::string_view name);
+
+  // records that the next line of the program is the given line of a file
+  void add(size_t file, size_t line);
+
+  // keeps the first count lines recorded
+  void truncate(size_t count);
+
+  size_t size() const;
+
+  // name ("" for the input) and line in that file of a 1-based program line
+  std::string_view fileOf(size_t line) const;
+  size_t lineOf(size_t line) const;
+
+  // "12", or "3 of lib.s" for a line that came from a module
+  std::string describe(size_t line) const;
+
+  // the source location as one number, for hashing; program lines of the
+  // input keep their own number
+  size_t key(size_t line) const;
+
+  private:
+
+  std::vector<std::string> mFiles { std::string { } };
+  std::vector<std::pair<uint32_t, uint32_t>> mLines; // file, line
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// resolves .include "FILE" before a program runs. each included file becomes
+// a module named after its file stem whose labels are renamed to NAME.label,
+// along with the branches inside it that refer to them; other code reaches
+// them as NAME.label. modules are read and renamed once per process and kept
+// until their file's modification time changes, so batch and server runs
+// share them. the include line is replaced by the module text in place.
+
+class CLinker {
+
+  public:
+
+  // the program with its includes expanded (paths are relative to
+  // directory), or nullopt after reporting a missing file, an include cycle
+  // or a branch to an undefined NAME.label. sources, if given, receives the
+  // origin of each line of the program.
+  static std::optional<std::string> Link(
+    std::string_view source,
+    std::filesystem::path const & directory,
+    CSourceMap * sources = nullptr
+  );
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
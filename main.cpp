@@ -2,16 +2,38 @@
 // ========================================================================== //
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <exception>
+#include <filesystem>
 #include <fstream>
 #include <iterator>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
 
+#include "callgraph.hpp"
+#include "coverage.hpp"
 #include "docopt.h"
+#include "fifo.hpp"
+#include "forkserver.hpp"
 #include "instruction.hpp"
 #include "interpreter.hpp"
+#include "linker.hpp"
+#include "output.hpp"
+#include "predictor.hpp"
 #include "processor.hpp"
+#include "profiler.hpp"
+#include "repl.hpp"
+#include "server.hpp"
+#include "snapshot.hpp"
+#include "timing.hpp"
 
 // -------------------------------------------------------------------------- //
 
@@ -19,14 +41,54 @@ static char const DOCOPT_STRING[] =
 R"(
   Usage:
     ippc [options] <input>
+    ippc [options] --repl
+    ippc --serve=SOCKET [--workers=N]
+
+  An <input> of - reads the program from stdin.
 
   Options:
-    -h, --help              show this help
-    -m=FILE, --memory=FILE  initialize memory with the contents of a file
+    -h, --help                show this help
+    -m=FILE, --memory=FILE    initialize memory with the contents of a file
+    -c, --cycles              estimate Gekko cycle counts per label
+    -b, --branches            report static branch mispredictions per site
+    -p=FILE, --profile=FILE   profile hot lines and mnemonics into a JSON file
+    -g=FILE, --folded=FILE    write folded call stacks for flamegraph.pl
+    -f=FILE, --fifo=FILE      capture writes to the gather pipe into a file
+    -r=FILE, --restore=FILE   resume from a snapshot written by .snapshot
+    --fork-server             run to .fuzz, then serve inputs over stdin/stdout
+    -e=FILE, --edges=FILE     write the AFL-style edge coverage map to a file
+    --max-instructions=N      stop with status 125 after N operations
+    --timeout=MS              stop with status 124 after MS milliseconds
+    --serve=SOCKET            run programs sent over a Unix socket
+    --workers=N               number of server worker processes [default: 0]
+    --repl                    enter and run lines interactively (see :help)
 )";
 
 // -------------------------------------------------------------------------- //
 
+static std::optional<uint64_t> ReadNumber(
+  docopt::value const & arg
+) {
+  if (!arg) {
+    return std::nullopt;
+  }
+
+  std::string const & text { arg.asString() };
+  uint64_t value { 0 };
+
+  auto const [end, error] = std::from_chars(
+    text.data(), (text.data() + text.size()), value
+  );
+
+  if (error != std::errc {} || end != (text.data() + text.size())) {
+    return std::nullopt;
+  }
+
+  return value;
+}
+
+// -------------------------------------------------------------------------- //
+
 int main(
   int const argc,
   char ** const argv
@@ -37,25 +99,239 @@ int main(
     true, "ippc++ v0.2.0"
   );
 
-  std::ifstream stream;
-  gStream = &stream;
+  if (args["--serve"]) {
+    std::optional<uint64_t> const workers { ReadNumber(args["--workers"]) };
 
-  stream.open(args["<input>"].asString());
+    if (workers == std::nullopt) {
+      std::cerr << "bad worker count." << std::endl;
+      return 1;
+    }
 
-  if (!stream.is_open()) {
-    std::cerr << "failed to open file." << std::endl;
-    return 1;
+    CServer server { size_t(*workers) };
+    return server.serve(args["--serve"].asString());
+  }
+
+  bool const repl { args["--repl"].asBool() };
+  bool const fork_server { args["--fork-server"].asBool() };
+  std::istringstream stream;
+  CSourceMap sources;
+
+  // branches seek, so the program is read whole into memory, where its
+  // includes are expanded; the session sets up its own program stream
+  if (!repl) {
+    std::string const input { args["<input>"].asString() };
+    std::filesystem::path directory { "." };
+    std::string source;
+
+    if (input == "-") {
+      if (fork_server) {
+        std::cerr << "the fork server needs stdin for its inputs.";
+        std::cerr << std::endl;
+        return 1;
+      }
+
+      source.assign(std::istreambuf_iterator<char> { std::cin }, { });
+    } else {
+      std::ifstream file { input, std::ios::binary };
+
+      if (!file.is_open()) {
+        std::cerr << "failed to open file." << std::endl;
+        return 1;
+      }
+
+      source.assign(std::istreambuf_iterator<char> { file }, { });
+      directory = std::filesystem::path { input }.parent_path();
+    }
+
+    std::optional<std::string> program {
+      CLinker::Link(source, directory, &sources)
+    };
+
+    if (program == std::nullopt) {
+      return 1;
+    }
+
+    stream.str(std::move(*program));
+    gStream = &stream;
   }
 
+  // stdout carries fork server responses, so program output is dropped
+  COutput output { fork_server ? nullptr : stdout };
+  gOutput = &output;
+
+  // buffered program output must not be lost when a fault terminates us
+  std::set_terminate([] () {
+    gOutput->flush();
+    std::abort();
+  });
+
   CInterpreter interpreter;
+  interpreter.sources() = std::move(sources);
   gInterpreter = &interpreter;
 
+  std::optional<uint64_t> const max_instructions {
+    ReadNumber(args["--max-instructions"])
+  };
+
+  std::optional<uint64_t> const timeout { ReadNumber(args["--timeout"]) };
+
+  if ((args["--max-instructions"] && max_instructions == std::nullopt) ||
+      (args["--timeout"] && timeout == std::nullopt)) {
+    std::cerr << "bad limit." << std::endl;
+    return 1;
+  }
+
+  if (max_instructions != std::nullopt || timeout != std::nullopt) {
+    std::optional<std::chrono::milliseconds> duration;
+
+    if (timeout != std::nullopt) {
+      duration = std::chrono::milliseconds { *timeout };
+    }
+
+    interpreter.limit(max_instructions, duration);
+  }
+
   CProcessor processor;
   gPPC = &processor;
 
-  while (interpreter.interpret());
+  if (args["--restore"]) {
+    CSnapshot snapshot;
+
+    if (!snapshot.read(args["--restore"].asString())) {
+      std::cerr << "failed to read snapshot." << std::endl;
+      return 1;
+    }
+
+    ERestore const restored { snapshot.restore(processor, interpreter) };
+
+    if (restored == ERESTORE_PROGRAM) {
+      std::cerr << "snapshot belongs to a different program." << std::endl;
+      return 1;
+    }
+
+    if (restored != ERESTORE_OK) {
+      std::cerr << "bad snapshot." << std::endl;
+      return 1;
+    }
+  }
+
+  CForkServer forkserver;
+
+  if (fork_server) {
+    gForkServer = &forkserver;
+  }
+
+  CCoverage coverage;
+
+  // an AFL-style shared map in the environment turns recording on as well
+  if (args["--edges"] || coverage.attach()) {
+#ifdef BUILD_NO_COVERAGE
+    std::cerr << "edge coverage is not available in this build." << std::endl;
+    return 1;
+#else
+    gCoverage = &coverage;
+#endif
+  }
+
+  CFifo fifo;
+
+  if (args["--fifo"]) {
+    fifo.attach(processor);
+  }
+
+  CTiming timing;
+
+  if (args["--cycles"].asBool()) {
+    gTiming = &timing;
+  }
+
+  CPredictor predictor;
+
+  if (args["--branches"].asBool()) {
+    gPredictor = &predictor;
+  }
+
+  CProfiler profiler;
+
+  if (args["--profile"]) {
+    gProfiler = &profiler;
+  }
+
+  CCallGraph callgraph;
+
+  if (args["--folded"]) {
+    gCallGraph = &callgraph;
+  }
+
+  if (repl) {
+    CRepl session { processor, interpreter };
+    session.run(std::cin, std::cout);
+  } else {
+    interpreter.run();
+  }
+
+  if (interpreter.halted() == EHALT_INSTRUCTIONS) {
+    std::cerr << "stopped on line " << interpreter.where(interpreter.line());
+    std::cerr << " after " << interpreter.executed() << " operations.";
+    std::cerr << std::endl;
+  } else if (interpreter.halted() == EHALT_TIMEOUT) {
+    std::cerr << "stopped on line " << interpreter.where(interpreter.line());
+    std::cerr << " after " << *timeout << " ms." << std::endl;
+  }
+
+  if (gForkServer != nullptr) {
+    if (!gForkServer->armed()) {
+      std::cerr << "program stopped before reaching .fuzz." << std::endl;
+      return 1;
+    }
+
+    return gForkServer->serve(processor, interpreter);
+  }
+
+  output.flush();
+
+  if (args["--edges"] && !coverage.write(args["--edges"].asString())) {
+    std::cerr << "failed to write edge coverage." << std::endl;
+    return 1;
+  }
+
+  if (args["--fifo"] && !fifo.write(args["--fifo"].asString())) {
+    std::cerr << "failed to write fifo data." << std::endl;
+    return 1;
+  }
+
+  if (gTiming != nullptr) {
+    gTiming->report(std::cerr);
+  }
+
+  if (gPredictor != nullptr) {
+    gPredictor->report(std::cerr, interpreter.sources());
+  }
+
+  if (gCallGraph != nullptr) {
+    std::ofstream folded { args["--folded"].asString() };
+
+    if (!folded.is_open()) {
+      std::cerr << "failed to write folded stacks." << std::endl;
+      return 1;
+    }
+
+    // weight by estimated cycles when the cycle model is running
+    gCallGraph->fold(folded, (gTiming != nullptr));
+  }
+
+  if (gProfiler != nullptr) {
+    gProfiler->report(std::cerr, interpreter.sources());
+
+    std::string const path { args["--profile"].asString() };
+
+    if (!gProfiler->write(path, interpreter.sources())) {
+      std::cerr << "failed to write profile." << std::endl;
+      return 1;
+    }
+  }
 
-  return 0;
+  return interpreter.status();
 }
 
 // -------------------------------------------------------------------------- //
@@ -0,0 +1,99 @@
+// ========================================================================== //
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "output.hpp"
+
+// -------------------------------------------------------------------------- //
+
+COutput * gOutput { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+COutput::COutput(
+  std::FILE * const sink
+) :
+  mSink { sink },
+  mBuffer { new char[CAPACITY] }
+{ }
+
+// -------------------------------------------------------------------------- //
+
+COutput::COutput(
+  std::string & capture
+) :
+  mCapture { &capture },
+  mBuffer { new char[CAPACITY] }
+{ }
+
+// -------------------------------------------------------------------------- //
+
+COutput::~COutput() {
+  flush();
+  delete[] mBuffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+void COutput::write(
+  std::string_view const text
+) {
+  if (text.size() > (CAPACITY - mSize)) {
+    flush();
+
+    if (text.size() > CAPACITY) {
+      if (mCapture != nullptr) {
+        mCapture->append(text);
+      } else if (mSink != nullptr) {
+        std::fwrite(text.data(), 1, text.size(), mSink);
+      }
+
+      return;
+    }
+  }
+
+  std::memcpy((mBuffer + mSize), text.data(), text.size());
+  mSize += text.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+void COutput::put(
+  char const c
+) {
+  if (mSize == CAPACITY) {
+    flush();
+  }
+
+  mBuffer[mSize++] = c;
+}
+
+// -------------------------------------------------------------------------- //
+
+void COutput::flush() {
+  if (mCapture != nullptr) {
+    mCapture->append(mBuffer, mSize);
+    mSize = 0;
+    return;
+  }
+
+  if (mSink == nullptr) {
+    mSize = 0;
+    return;
+  }
+
+  if (mSize > 0) {
+    std::fwrite(mBuffer, 1, mSize, mSink);
+    mSize = 0;
+  }
+
+  std::fflush(mSink);
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
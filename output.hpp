@@ -0,0 +1,54 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_OUTPUT_HPP
+#define INCLUDE_OUTPUT_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// -------------------------------------------------------------------------- //
+
+// program output is collected in a single reusable buffer and written to the
+// sink only when the buffer fills or flush() is called (at exit). a null sink
+// discards the output; a string sink collects it for embedders.
+
+class COutput {
+
+  public:
+
+  static size_t const CAPACITY { 64 * 1024 };
+
+  explicit COutput(std::FILE * sink = stdout);
+  explicit COutput(std::string & capture);
+  ~COutput();
+
+  COutput(COutput const &) = delete;
+  COutput & operator=(COutput const &) = delete;
+
+  void write(std::string_view text);
+  void put(char c);
+
+  void flush();
+
+  private:
+
+  std::FILE * mSink { nullptr };
+  std::string * mCapture { nullptr };
+  char * mBuffer { nullptr };
+  size_t mSize { 0 };
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern COutput * gOutput;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,135 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// static branch prediction
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "instruction.hpp"
+#include "linker.hpp"
+#include "predictor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+CPredictor * gPredictor { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+bool CPredictor::Predict(
+  uint8_t const bits,
+  bool const relative,
+  bool const backward
+) {
+  if (bits & EBIT_Y) {
+    return true;
+  }
+
+  if (bits & EBIT_N) {
+    return false;
+  }
+
+  return (relative && backward);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CPredictor::record(
+  size_t const line,
+  std::string_view const region,
+  bool const predicted,
+  bool const taken
+) {
+  CSite & site { mSites[line] };
+
+  if (site.executed == 0) {
+    site.region = region;
+  }
+
+  ++site.executed;
+  ++mBranches;
+
+  if (taken) {
+    ++site.taken;
+  }
+
+  if (predicted != taken) {
+    ++site.mispredicted;
+    ++mMispredictions;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t CPredictor::branches() const {
+  return mBranches;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t CPredictor::mispredictions() const {
+  return mMispredictions;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CPredictor::report(
+  std::ostream & stream,
+  CSourceMap const & sources,
+  size_t const count
+) const {
+  std::vector<std::pair<size_t, CSite const *>> sites;
+
+  for (auto const & [line, site] : mSites) {
+    if (site.mispredicted > 0) {
+      sites.emplace_back(line, &site);
+    }
+  }
+
+  std::sort(
+    sites.begin(), sites.end(),
+    [] (auto const & lhs, auto const & rhs) {
+      if (lhs.second->mispredicted != rhs.second->mispredicted) {
+        return (lhs.second->mispredicted > rhs.second->mispredicted);
+      }
+
+      return (lhs.first < rhs.first);
+    }
+  );
+
+  if (sites.size() > count) {
+    sites.resize(count);
+  }
+
+  stream << "conditional branches: " << mBranches;
+  stream << " (" << mMispredictions << " mispredicted)" << std::endl;
+
+  for (auto const & [line, site] : sites) {
+    double const rate {
+      100.0 * double(site->mispredicted) / double(site->executed)
+    };
+
+    stream << "  line " << std::setw(6) << std::left;
+    stream << sources.describe(line) << std::right;
+    stream << std::setw(12) << site->mispredicted << " / ";
+    stream << std::setw(12) << std::left << site->executed << std::right;
+    stream << std::fixed << std::setprecision(1) << std::setw(6) << rate;
+    stream << "%  taken " << site->taken << std::defaultfloat;
+
+    if (!site->region.empty()) {
+      stream << "  in " << site->region;
+    }
+
+    stream << std::endl;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
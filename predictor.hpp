@@ -0,0 +1,71 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_PREDICTOR_HPP
+#define INCLUDE_PREDICTOR_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "linker.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// simulates the Gekko's static branch prediction: '+'/'-' hints force the
+// prediction, otherwise relative branches are predicted backward-taken/
+// forward-not-taken and branches to LR/CTR are predicted not taken.
+
+class CPredictor {
+
+  public:
+
+  static bool Predict(uint8_t bits, bool relative, bool backward);
+
+  void record(
+    size_t line,
+    std::string_view region,
+    bool predicted,
+    bool taken
+  );
+
+  uint64_t branches() const;
+  uint64_t mispredictions() const;
+
+  // lines are named through sources, which maps them back to their files
+  void report(
+    std::ostream & stream,
+    CSourceMap const & sources,
+    size_t count = 10
+  ) const;
+
+  private:
+
+  struct CSite {
+
+    std::string region;
+    uint64_t executed { 0 };
+    uint64_t taken { 0 };
+    uint64_t mispredicted { 0 };
+
+  };
+
+  std::unordered_map<size_t, CSite> mSites;
+  uint64_t mBranches { 0 };
+  uint64_t mMispredictions { 0 };
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern CPredictor * gPredictor;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -1,6 +1,18 @@
 
 --------------------------------------------------------------------------------
 
+newoption {
+  trigger = "no-coverage",
+  description = "Compile out edge coverage recording"
+}
+
+newoption {
+  trigger = "static-lib",
+  description = "Build libippc as a static instead of a shared library"
+}
+
+--------------------------------------------------------------------------------
+
 workspace "ippc"
 startproject "ippc"
 
@@ -25,6 +37,10 @@ optimize "on"
 runtime "release"
 filter { }
 
+filter { "options:no-coverage" }
+defines "BUILD_NO_COVERAGE"
+filter { }
+
 --------------------------------------------------------------------------------
 
 project "ippc"
@@ -39,3 +55,46 @@ includedirs { "." }
 files { "*.hpp", "*.h", "*.cpp" }
 
 --------------------------------------------------------------------------------
+
+-- the interpreter core with the C API in ippc.h. instructions and directives
+-- register themselves from static initializers, so a static libippc has to
+-- be linked whole (--whole-archive, -force_load or /WHOLEARCHIVE).
+
+project "libippc"
+kind "SharedLib"
+language "C++"
+cppdialect "C++17"
+targetname "ippc"
+
+targetdir "build/%{cfg.buildcfg}/lib/"
+objdir "build/%{cfg.buildcfg}/obj/%{prj.name}/"
+
+includedirs { "." }
+files { "*.hpp", "*.h", "*.cpp" }
+removefiles { "main.cpp", "docopt*" }
+defines { "IPPC_BUILD", "IPPC_SHARED" }
+
+filter { "options:static-lib" }
+kind "StaticLib"
+removedefines "IPPC_SHARED"
+filter { }
+
+--------------------------------------------------------------------------------
+
+-- stand-in for ippc that runs programs on an ippc --serve daemon
+
+project "ippc-client"
+kind "ConsoleApp"
+language "C++"
+cppdialect "C++17"
+
+targetdir "build/%{cfg.buildcfg}/bin/"
+objdir "build/%{cfg.buildcfg}/obj/%{prj.name}/"
+
+files { "client/*.cpp" }
+
+filter { "system:windows" }
+kind "None"
+filter { }
+
+--------------------------------------------------------------------------------
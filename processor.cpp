@@ -1,13 +1,23 @@
 
 // ========================================================================== //
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include <exception>
-#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
 
 #include "processor.hpp"
+#include "snapshot.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// byte-reversed accesses are plain host accesses on little-endian hosts
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define HOST_BIG_ENDIAN
+#endif
 
 // -------------------------------------------------------------------------- //
 
@@ -147,13 +157,282 @@ CProcessor::CProcessor(
 
     mMemorySize = memory_size;
     std::memset(mMemory, 0, mMemorySize);
+
+    // cached and uncached mirrors of main memory
+    size_t const size { std::min<size_t>(mMemorySize, 0x40000000) };
+    map(0x80000000, mMemory, size);
+    map(0xC0000000, mMemory, size);
   }
+
+  map(LOCKED_CACHE_ADDR, mLockedCache, LOCKED_CACHE_SIZE);
+  mDirty.resize((mMemorySize + PAGE_SIZE - 1) / PAGE_SIZE, 0);
+
+  // reset() without a baseline returns to this state with zeroed memory
+  std::ostringstream state { std::ios::binary };
+  saveState(state);
+  mBaselineState = std::move(state).str();
 }
 
 // -------------------------------------------------------------------------- //
 
 CProcessor::~CProcessor() {
   operator delete(mMemory);
+  operator delete(mBaseline);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::map(
+  size_t const addr,
+  uint8_t * const memory,
+  size_t const size
+) {
+  // partial trailing pages are not mapped
+  for (size_t offset { 0 }; (offset + PAGE_SIZE) <= size; offset += PAGE_SIZE) {
+    mapPage(addr + offset) = CPage { (memory + offset), 0 };
+  }
+
+  flushTLB();
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::mmio(
+  size_t const addr,
+  size_t const size,
+  CMMIORead read,
+  CMMIOWrite write
+) {
+  mDevices.push_back(CDevice { std::move(read), std::move(write) });
+  auto const device = static_cast<uint16_t>(mDevices.size());
+
+  for (size_t offset { 0 }; offset < size; offset += PAGE_SIZE) {
+    mapPage(addr + offset) = CPage { nullptr, device };
+  }
+
+  flushTLB();
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::save(
+  std::ostream & stream
+) const {
+  WriteRaw(stream, uint64_t(mMemorySize));
+  saveState(stream);
+
+  // main memory as (page index, contents) pairs, skipping all-zero pages
+  size_t const page_count { mMemorySize / PAGE_SIZE };
+
+  for (size_t page_no { 0 }; page_no < page_count; ++page_no) {
+    uint8_t const * const data { mMemory + (page_no * PAGE_SIZE) };
+
+    bool const zero {
+      std::all_of(data, (data + PAGE_SIZE), [] (uint8_t const b) {
+        return (b == 0);
+      })
+    };
+
+    if (!zero) {
+      WriteRaw(stream, uint32_t(page_no));
+      stream.write(reinterpret_cast<char const *>(data), PAGE_SIZE);
+    }
+  }
+
+  WriteRaw(stream, ~uint32_t(0));
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CProcessor::load(
+  std::istream & stream
+) {
+  uint64_t memory_size { 0 };
+
+  if (!ReadRaw(stream, memory_size) || memory_size != mMemorySize) {
+    return false;
+  }
+
+  if (!loadState(stream)) {
+    return false;
+  }
+
+  std::memset(mMemory, 0, mMemorySize);
+  markDirty(mMemory, mMemorySize);
+
+  for (;;) {
+    uint32_t page_no { 0 };
+
+    if (!ReadRaw(stream, page_no)) {
+      return false;
+    }
+
+    if (page_no == ~uint32_t(0)) {
+      return true;
+    }
+
+    if (page_no >= (mMemorySize / PAGE_SIZE)) {
+      return false;
+    }
+
+    stream.read(
+      reinterpret_cast<char *>(mMemory + (page_no * PAGE_SIZE)), PAGE_SIZE
+    );
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::baseline() {
+  if (mBaseline == nullptr) {
+    mBaseline = reinterpret_cast<uint8_t *>(
+      operator new(mMemorySize)
+    );
+  }
+
+  std::memcpy(mBaseline, mMemory, mMemorySize);
+
+  std::ostringstream state { std::ios::binary };
+  saveState(state);
+  mBaselineState = std::move(state).str();
+
+  for (uint32_t const page_no : mDirtyPages) {
+    mDirty[page_no] = 0;
+  }
+
+  mDirtyPages.clear();
+  flushTLB();
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::reset() {
+  for (uint32_t const page_no : mDirtyPages) {
+    uint8_t * const data { mMemory + (size_t(page_no) * PAGE_SIZE) };
+    size_t const size {
+      std::min(PAGE_SIZE, (mMemorySize - (size_t(page_no) * PAGE_SIZE)))
+    };
+
+    if (mBaseline != nullptr) {
+      std::memcpy(data, (mBaseline + (size_t(page_no) * PAGE_SIZE)), size);
+    } else {
+      std::memset(data, 0, size);
+    }
+
+    mDirty[page_no] = 0;
+  }
+
+  mDirtyPages.clear();
+  flushTLB();
+
+  std::istringstream state { mBaselineState, std::ios::binary };
+  loadState(state);
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t CProcessor::dirtyPages() const {
+  return mDirtyPages.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::saveState(
+  std::ostream & stream
+) const {
+  for (CGPR const & gpr : mGPR) {
+    WriteRaw(stream, gpr.u32());
+  }
+
+  for (CFPR const & fpr : mFPR) {
+    WriteRaw(stream, fpr.u64());
+  }
+
+  for (size_t i { 0 }; i < 8; ++i) {
+    WriteRaw(stream, mfspr(ESPR_GQR0 + i));
+  }
+
+  WriteRaw(stream, mCTR);
+  WriteRaw(stream, mLR);
+  WriteRaw(stream, mCR);
+  WriteRaw(stream, mXER);
+  WriteRaw(stream, mXERCount);
+  WriteRaw(stream, mHID2);
+  WriteRaw(stream, mDMAU);
+  WriteRaw(stream, mDMAL);
+  WriteRaw(stream, mLockedCache);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CProcessor::loadState(
+  std::istream & stream
+) {
+  for (CGPR & gpr : mGPR) {
+    uint32_t value { 0 };
+    ReadRaw(stream, value);
+    gpr = CGPR { value };
+  }
+
+  for (CFPR & fpr : mFPR) {
+    uint64_t value { 0 };
+    ReadRaw(stream, value);
+    fpr = CFPR { value };
+  }
+
+  for (size_t i { 0 }; i < 8; ++i) {
+    uint32_t value { 0 };
+    ReadRaw(stream, value);
+    mtspr((ESPR_GQR0 + i), value);
+  }
+
+  ReadRaw(stream, mCTR);
+  ReadRaw(stream, mLR);
+  ReadRaw(stream, mCR);
+  ReadRaw(stream, mXER);
+  ReadRaw(stream, mXERCount);
+  ReadRaw(stream, mHID2);
+  ReadRaw(stream, mDMAU);
+  ReadRaw(stream, mDMAL);
+  clearFault();
+  return ReadRaw(stream, mLockedCache);
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::markDirty(
+  uint8_t const * const memory,
+  size_t const size
+) {
+  if (
+    size == 0 ||
+    memory < mMemory ||
+    memory >= (mMemory + mMemorySize)
+  ) {
+    return;
+  }
+
+  size_t const first { size_t(memory - mMemory) / PAGE_SIZE };
+  size_t const last { (size_t(memory - mMemory) + size - 1) / PAGE_SIZE };
+
+  for (size_t page_no { first }; page_no <= last; ++page_no) {
+    if (mDirty[page_no] == 0) {
+      mDirty[page_no] = 1;
+      mDirtyPages.push_back(uint32_t(page_no));
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::flushTLB() {
+  for (CTLBEntry & entry : mTLB) {
+    entry = CTLBEntry { };
+  }
+
+  for (CTLBEntry & entry : mWriteTLB) {
+    entry = CTLBEntry { };
+  }
 }
 
 // -------------------------------------------------------------------------- //
@@ -272,6 +551,132 @@ CProcessor::xer() const {
 
 // -------------------------------------------------------------------------- //
 
+uint8_t &
+CProcessor::xerCount() {
+  return mXERCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t const &
+CProcessor::xerCount() const {
+  return mXERCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::mtspr(
+  size_t const spr,
+  uint32_t const value
+) {
+  switch (spr) {
+    case ESPR_XER: {
+      mXER = 0;
+
+      if (value & 0x80000000) { mXER |= EXER_S0; }
+      if (value & 0x40000000) { mXER |= EXER_OV; }
+      if (value & 0x20000000) { mXER |= EXER_CA; }
+
+      mXERCount = static_cast<uint8_t>(value & 0x7F);
+      break;
+    }
+    case ESPR_LR: {
+      mLR = value;
+      break;
+    }
+    case ESPR_CTR: {
+      mCTR = value;
+      break;
+    }
+    case ESPR_DSISR: {
+      mDSISR = value;
+      break;
+    }
+    case ESPR_DAR: {
+      mDAR = value;
+      break;
+    }
+    case ESPR_HID2: {
+      mHID2 = value;
+      break;
+    }
+    case ESPR_DMAU: {
+      mDMAU = value;
+      break;
+    }
+    case ESPR_DMAL: {
+      mDMAL = value;
+
+      if (mDMAL & 0x2) {
+        dma();
+      }
+
+      break;
+    }
+    default: {
+      CGQR & gqr { mGQR[spr - ESPR_GQR0] };
+
+      // scales are 6-bit signed fields
+      gqr.stype = static_cast<EGQR>(value & 0x7);
+      gqr.sscale = (static_cast<int32_t>(value << 18) >> 26);
+      gqr.ltype = static_cast<EGQR>((value >> 16) & 0x7);
+      gqr.lscale = (static_cast<int32_t>(value << 2) >> 26);
+      break;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t CProcessor::mfspr(
+  size_t const spr
+) const {
+  switch (spr) {
+    case ESPR_XER: {
+      uint32_t value { mXERCount };
+
+      if (mXER & EXER_S0) { value |= 0x80000000; }
+      if (mXER & EXER_OV) { value |= 0x40000000; }
+      if (mXER & EXER_CA) { value |= 0x20000000; }
+
+      return value;
+    }
+    case ESPR_LR: {
+      return mLR;
+    }
+    case ESPR_CTR: {
+      return mCTR;
+    }
+    case ESPR_DSISR: {
+      return mDSISR;
+    }
+    case ESPR_DAR: {
+      return mDAR;
+    }
+    case ESPR_HID2: {
+      return mHID2;
+    }
+    case ESPR_DMAU: {
+      return mDMAU;
+    }
+    case ESPR_DMAL: {
+      return mDMAL;
+    }
+    default: {
+      CGQR const & gqr { mGQR[spr - ESPR_GQR0] };
+
+      return (
+        static_cast<uint32_t>(gqr.stype) |
+        ((static_cast<uint32_t>(gqr.sscale) & 0x3F) << 8) |
+        (static_cast<uint32_t>(gqr.ltype) << 16) |
+        ((static_cast<uint32_t>(gqr.lscale) & 0x3F) << 24)
+      );
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
 size_t CProcessor::ea(
   int16_t const d,
   size_t const ra
@@ -281,7 +686,7 @@ size_t CProcessor::ea(
   }
 
   return static_cast<size_t>(
-    mGPR[ra].u16() + d
+    uint32_t(mGPR[ra].u32() + uint32_t(d))
   );
 }
 
@@ -307,7 +712,7 @@ size_t CProcessor::ea(
 uint8_t CProcessor::lbz(
   size_t const addr
 ) const {
-  return ram(addr);
+  return load<uint8_t>(addr);
 }
 
 // -------------------------------------------------------------------------- //
@@ -323,10 +728,7 @@ int16_t CProcessor::lha(
 uint16_t CProcessor::lhz(
   size_t const addr
 ) const {
-  return static_cast<uint16_t>(
-    (static_cast<uint16_t>(ram(addr)) << 8) |
-    static_cast<uint16_t>(ram(addr + 1))
-  );
+  return load<uint16_t>(addr);
 }
 
 // -------------------------------------------------------------------------- //
@@ -334,12 +736,7 @@ uint16_t CProcessor::lhz(
 uint32_t CProcessor::lwz(
   size_t const addr
 ) const {
-  return static_cast<uint32_t>(
-    (static_cast<uint32_t>(ram(addr)) << 24) |
-    (static_cast<uint32_t>(ram(addr + 1)) << 16) |
-    (static_cast<uint32_t>(ram(addr + 2)) << 8) |
-    static_cast<uint32_t>(ram(addr + 3))
-  );
+  return load<uint32_t>(addr);
 }
 
 // -------------------------------------------------------------------------- //
@@ -375,11 +772,63 @@ double CProcessor::lfd(
 
 // -------------------------------------------------------------------------- //
 
+uint16_t CProcessor::lhbrx(
+  size_t const addr
+) const {
+  uint8_t const * const data { mapped(addr, sizeof(uint16_t)) };
+  uint16_t h;
+
+  // device pages see a big-endian access, which is then reversed here
+  if (data == nullptr) {
+    h = load<uint16_t>(addr);
+    return static_cast<uint16_t>((h << 8) | (h >> 8));
+  }
+
+  std::memcpy(&h, data, sizeof(h));
+
+#ifdef HOST_BIG_ENDIAN
+  h = static_cast<uint16_t>((h << 8) | (h >> 8));
+#endif
+
+  return h;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t CProcessor::lwbrx(
+  size_t const addr
+) const {
+  uint8_t const * const data { mapped(addr, sizeof(uint32_t)) };
+  uint32_t w;
+
+  if (data == nullptr) {
+    w = load<uint32_t>(addr);
+
+    return (
+      (w << 24) | ((w << 8) & 0x00FF0000) |
+      ((w >> 8) & 0x0000FF00) | (w >> 24)
+    );
+  }
+
+  std::memcpy(&w, data, sizeof(w));
+
+#ifdef HOST_BIG_ENDIAN
+  w = (
+    (w << 24) | ((w << 8) & 0x00FF0000) |
+    ((w >> 8) & 0x0000FF00) | (w >> 24)
+  );
+#endif
+
+  return w;
+}
+
+// -------------------------------------------------------------------------- //
+
 void CProcessor::stb(
   size_t const addr,
   uint8_t const b
 ) {
-  ram(addr) = b;
+  store<uint8_t>(addr, b);
 }
 
 // -------------------------------------------------------------------------- //
@@ -388,8 +837,7 @@ void CProcessor::sth(
   size_t const addr,
   uint16_t const h
 ) {
-  ram(addr) = static_cast<uint8_t>((h >> 8) & 0xFF);
-  ram(addr + 1) = static_cast<uint8_t>(h & 0xFF);
+  store<uint16_t>(addr, h);
 }
 
 // -------------------------------------------------------------------------- //
@@ -398,10 +846,7 @@ void CProcessor::stw(
   size_t const addr,
   uint32_t w
 ) {
-  ram(addr) = static_cast<uint8_t>((w >> 24) & 0xFF);
-  ram(addr + 1) = static_cast<uint8_t>((w >> 16) & 0xFF);
-  ram(addr + 2) = static_cast<uint8_t>((w >> 8) & 0xFF);
-  ram(addr + 3) = static_cast<uint8_t>(w & 0xFF);
+  store<uint32_t>(addr, w);
 }
 
 // -------------------------------------------------------------------------- //
@@ -437,6 +882,251 @@ void CProcessor::stfd(
 
 // -------------------------------------------------------------------------- //
 
+void CProcessor::sthbrx(
+  size_t const addr,
+  uint16_t h
+) {
+  uint8_t * const data { mutableMapped(addr, sizeof(uint16_t)) };
+
+  if (data == nullptr) {
+    store<uint16_t>(addr, static_cast<uint16_t>((h << 8) | (h >> 8)));
+    return;
+  }
+
+#ifdef HOST_BIG_ENDIAN
+  h = static_cast<uint16_t>((h << 8) | (h >> 8));
+#endif
+
+  std::memcpy(data, &h, sizeof(h));
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::stwbrx(
+  size_t const addr,
+  uint32_t w
+) {
+  uint8_t * const data { mutableMapped(addr, sizeof(uint32_t)) };
+
+  if (data == nullptr) {
+    store<uint32_t>(addr, (
+      (w << 24) | ((w << 8) & 0x00FF0000) |
+      ((w >> 8) & 0x0000FF00) | (w >> 24)
+    ));
+
+    return;
+  }
+
+#ifdef HOST_BIG_ENDIAN
+  w = (
+    (w << 24) | ((w << 8) & 0x00FF0000) |
+    ((w >> 8) & 0x0000FF00) | (w >> 24)
+  );
+#endif
+
+  std::memcpy(data, &w, sizeof(w));
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::lmw(
+  size_t const rt,
+  size_t const addr
+) {
+  size_t const count { 32 - rt };
+  uint8_t const * const data { mapped(addr, (count * 4)) };
+
+  // device pages see one access per word; unmapped words raise the DSI
+  if (data == nullptr) {
+    for (size_t i { 0 }; i < count; ++i) {
+      mGPR[rt + i] = CGPR { load<uint32_t>(addr + (i * 4)) };
+    }
+
+    return;
+  }
+
+  // the shift/or form compiles to a host load and byte swap per word
+  for (size_t i { 0 }; i < count; ++i) {
+    uint8_t const * const word { data + (i * 4) };
+
+    mGPR[rt + i] = CGPR {
+      (static_cast<uint32_t>(word[0]) << 24) |
+      (static_cast<uint32_t>(word[1]) << 16) |
+      (static_cast<uint32_t>(word[2]) << 8) |
+      static_cast<uint32_t>(word[3])
+    };
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::stmw(
+  size_t const rs,
+  size_t const addr
+) {
+  size_t const count { 32 - rs };
+  uint8_t * const data { mutableMapped(addr, (count * 4)) };
+
+  if (data == nullptr) {
+    for (size_t i { 0 }; i < count; ++i) {
+      store<uint32_t>((addr + (i * 4)), mGPR[rs + i].u32());
+    }
+
+    return;
+  }
+
+  for (size_t i { 0 }; i < count; ++i) {
+    uint32_t const w { mGPR[rs + i].u32() };
+    uint8_t * const word { data + (i * 4) };
+
+    word[0] = static_cast<uint8_t>(w >> 24);
+    word[1] = static_cast<uint8_t>(w >> 16);
+    word[2] = static_cast<uint8_t>(w >> 8);
+    word[3] = static_cast<uint8_t>(w);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::lsw(
+  size_t const rt,
+  size_t const addr,
+  size_t const count
+) {
+  if (count == 0) {
+    return;
+  }
+
+  uint8_t const * data { mapped(addr, count) };
+  uint8_t bytes[128]; // lswx moves at most 127 bytes, lswi 32
+
+  if (data == nullptr) {
+    for (size_t i { 0 }; i < count; ++i) {
+      bytes[i] = load<uint8_t>(addr + i);
+    }
+
+    data = bytes;
+  }
+
+  size_t r { rt };
+
+  // whole words first, then the tail left-justified and zero-filled
+  size_t i { 0 };
+
+  for (; (i + 4) <= count; i += 4, r = ((r + 1) % 32)) {
+    mGPR[r] = CGPR {
+      (static_cast<uint32_t>(data[i]) << 24) |
+      (static_cast<uint32_t>(data[i + 1]) << 16) |
+      (static_cast<uint32_t>(data[i + 2]) << 8) |
+      static_cast<uint32_t>(data[i + 3])
+    };
+  }
+
+  if (i < count) {
+    uint32_t w { 0 };
+
+    for (size_t shift { 24 }; i < count; ++i, shift -= 8) {
+      w |= (static_cast<uint32_t>(data[i]) << shift);
+    }
+
+    mGPR[r] = CGPR { w };
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::stsw(
+  size_t const rs,
+  size_t const addr,
+  size_t const count
+) {
+  if (count == 0) {
+    return;
+  }
+
+  uint8_t * const memory { mutableMapped(addr, count) };
+  uint8_t bytes[128]; // see lsw()
+  uint8_t * const data { (memory != nullptr) ? memory : bytes };
+  size_t r { rs };
+
+  for (size_t i { 0 }; i < count; r = ((r + 1) % 32)) {
+    uint32_t const w { mGPR[r].u32() };
+
+    for (size_t shift { 24 }; i < count && shift < 32; ++i, shift -= 8) {
+      data[i] = static_cast<uint8_t>(w >> shift);
+    }
+  }
+
+  if (memory == nullptr) {
+    for (size_t i { 0 }; i < count; ++i) {
+      store<uint8_t>((addr + i), bytes[i]);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::dcbz(
+  size_t const addr
+) {
+  size_t const line { addr & ~(CACHE_LINE_SIZE - 1) };
+  uint8_t * const data { mutableMapped(line, CACHE_LINE_SIZE) };
+
+  if (data == nullptr) {
+    for (size_t i { 0 }; i < CACHE_LINE_SIZE; i += 4) {
+      store<uint32_t>((line + i), 0);
+    }
+
+    return;
+  }
+
+  std::memset(data, 0, CACHE_LINE_SIZE);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t *
+CProcessor::host(
+  size_t const addr,
+  size_t const size
+) {
+  return writeMiss(addr, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t const *
+CProcessor::host(
+  size_t const addr,
+  size_t const size
+) const {
+  return translate(addr, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CProcessor::IsSPR(
+  size_t const spr
+) {
+  switch (spr) {
+    case ESPR_XER:
+    case ESPR_LR:
+    case ESPR_CTR:
+    case ESPR_DSISR:
+    case ESPR_DAR:
+    case ESPR_HID2:
+    case ESPR_DMAU:
+    case ESPR_DMAL: {
+      return true;
+    }
+    default: {
+      return (spr >= ESPR_GQR0 && spr < (ESPR_GQR0 + 8));
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
 uint32_t CProcessor::Mask(
   size_t const mb,
   size_t const me
@@ -475,48 +1165,300 @@ bool CProcessor::Carry(
 
 // -------------------------------------------------------------------------- //
 
-uint8_t &
+uint8_t const &
 CProcessor::ram(
+  size_t const addr,
+  size_t const size
+) const {
+  uint8_t const * const memory { mapped(addr, size) };
+
+  if (memory == nullptr) {
+    return *fault(addr, size, false);
+  }
+
+  return *memory;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t &
+CProcessor::mutableRam(
+  size_t const addr,
+  size_t const size
+) {
+  uint8_t * const memory { mutableMapped(addr, size) };
+
+  if (memory == nullptr) {
+    return *fault(addr, size, true);
+  }
+
+  return *memory;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t const *
+CProcessor::mapped(
+  size_t const addr,
+  size_t const size
+) const {
+  CTLBEntry const & entry { mTLB[(addr >> PAGE_BITS) % TLB_SIZE] };
+
+  // a single unsigned compare checks both the page and that the access does
+  // not run off its end
+  if ((addr - entry.addr) <= (PAGE_SIZE - size)) {
+    return (entry.memory + (addr - entry.addr));
+  }
+
+  return readMiss(addr, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t *
+CProcessor::mutableMapped(
+  size_t const addr,
+  size_t const size
+) {
+  CTLBEntry const & entry { mWriteTLB[(addr >> PAGE_BITS) % TLB_SIZE] };
+
+  if ((addr - entry.addr) <= (PAGE_SIZE - size)) {
+    return (entry.memory + (addr - entry.addr));
+  }
+
+  return writeMiss(addr, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<typename T>
+T CProcessor::load(
   size_t const addr
+) const {
+  CTLBEntry const & entry { mTLB[(addr >> PAGE_BITS) % TLB_SIZE] };
+  uint8_t const * data;
+
+  if ((addr - entry.addr) <= (PAGE_SIZE - sizeof(T))) {
+    data = (entry.memory + (addr - entry.addr));
+  } else if ((data = readMiss(addr, sizeof(T))) == nullptr) {
+    CDevice const * const mmio { device(addr) };
+
+    if (mmio == nullptr) {
+      fault(addr, sizeof(T), false);
+      return T { 0 };
+    }
+
+    return static_cast<T>(mmio->read(addr, sizeof(T)));
+  }
+
+  uint32_t value { 0 };
+
+  for (size_t i { 0 }; i < sizeof(T); ++i) {
+    value = ((value << 8) | data[i]);
+  }
+
+  return static_cast<T>(value);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<typename T>
+void CProcessor::store(
+  size_t const addr,
+  T const value
 ) {
-  if (addr < 0x80000000) {
-    std::cerr << "segfault" << std::endl;
-    std::terminate();
+  CTLBEntry const & entry { mWriteTLB[(addr >> PAGE_BITS) % TLB_SIZE] };
+  uint8_t * data;
+
+  if ((addr - entry.addr) <= (PAGE_SIZE - sizeof(T))) {
+    data = (entry.memory + (addr - entry.addr));
+  } else if ((data = writeMiss(addr, sizeof(T))) == nullptr) {
+    CDevice const * const mmio { device(addr) };
+
+    if (mmio == nullptr) {
+      fault(addr, sizeof(T), true);
+    } else {
+      mmio->write(addr, sizeof(T), value);
+    }
+
+    return;
   }
 
-  size_t const physical_addr {
-    addr & ~0xC0000000
-  };
+  for (size_t i { 0 }; i < sizeof(T); ++i) {
+    data[i] = static_cast<uint8_t>(value >> ((sizeof(T) - 1 - i) * 8));
+  }
+}
+
+// -------------------------------------------------------------------------- //
 
-  if (physical_addr >= mMemorySize) {
-    std::cerr << "segfault" << std::endl;
-    std::terminate();
+uint8_t *
+CProcessor::translate(
+  size_t const addr,
+  size_t const size
+) const {
+  if (addr > 0xFFFFFFFF || size > (0x100000000 - addr)) {
+    return nullptr;
+  }
+
+  CPage const * const first { page(addr) };
+
+  if (first == nullptr || first->memory == nullptr) {
+    return nullptr;
   }
 
-  return mMemory[physical_addr];
+  uint8_t * const memory { first->memory };
+  size_t const base { addr & ~(PAGE_SIZE - 1) };
+
+  // ranges that cross into further pages must be contiguous on the host
+  for (size_t next { base + PAGE_SIZE }; next < (addr + size); next += PAGE_SIZE) {
+    CPage const * const other { page(next) };
+
+    if (other == nullptr || other->memory != (memory + (next - base))) {
+      return nullptr;
+    }
+  }
+
+  return (memory + (addr - base));
 }
 
 // -------------------------------------------------------------------------- //
 
-uint8_t const &
-CProcessor::ram(
+uint8_t const *
+CProcessor::readMiss(
+  size_t const addr,
+  size_t const size
+) const {
+  uint8_t * const memory { translate(addr, size) };
+
+  if (memory != nullptr) {
+    size_t const base { addr & ~(PAGE_SIZE - 1) };
+    mTLB[(addr >> PAGE_BITS) % TLB_SIZE] = {
+      base, (memory - (addr - base))
+    };
+  }
+
+  return memory;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t *
+CProcessor::writeMiss(
+  size_t const addr,
+  size_t const size
+) {
+  uint8_t * const memory { translate(addr, size) };
+
+  if (memory != nullptr) {
+    size_t const base { addr & ~(PAGE_SIZE - 1) };
+    markDirty(memory, size);
+    mWriteTLB[(addr >> PAGE_BITS) % TLB_SIZE] = {
+      base, (memory - (addr - base))
+    };
+  }
+
+  return memory;
+}
+
+// -------------------------------------------------------------------------- //
+
+CProcessor::CPage const *
+CProcessor::page(
   size_t const addr
 ) const {
-  if (addr < 0x80000000) {
-    std::cerr << "segfault" << std::endl;
-    std::terminate();
+  size_t const page_no { addr >> PAGE_BITS };
+  std::vector<CPage> const & table { mPageTable[(page_no >> 10) & 0x3FF] };
+
+  if (table.empty()) {
+    return nullptr;
   }
 
-  size_t const physical_addr {
-    addr & ~0xC0000000
-  };
+  return &table[page_no & 0x3FF];
+}
+
+// -------------------------------------------------------------------------- //
+
+CProcessor::CPage &
+CProcessor::mapPage(
+  size_t const addr
+) {
+  size_t const page_no { addr >> PAGE_BITS };
+  std::vector<CPage> & table { mPageTable[(page_no >> 10) & 0x3FF] };
+
+  if (table.empty()) {
+    table.resize(1024);
+  }
+
+  return table[page_no & 0x3FF];
+}
+
+// -------------------------------------------------------------------------- //
+
+CProcessor::CDevice const *
+CProcessor::device(
+  size_t const addr
+) const {
+  CPage const * const mmio { page(addr) };
+
+  // accesses that straddle into a device page are not forwarded either
+  if (mmio == nullptr || mmio->device == 0) {
+    return nullptr;
+  }
+
+  return &mDevices[mmio->device - 1];
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t *
+CProcessor::fault(
+  size_t const addr,
+  size_t const size,
+  bool const store
+) const {
+  // only the first fault is reported; the program stops after the operation
+  if (!mFaulted) {
+    mFaulted = true;
+    mDAR = static_cast<uint32_t>(addr);
+    mDSISR = (EDSISR_PAGE | (store ? uint32_t(EDSISR_STORE) : 0u));
+  }
+
+  std::memset(mFaultSink, 0, size);
+  return mFaultSink;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::clearFault() {
+  mFaulted = false;
+  mDAR = 0;
+  mDSISR = 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProcessor::dma() {
+  // DMA_U: memory address and length (high bits) in cache lines
+  // DMA_L: locked cache address, direction, length (low bits), trigger, flush
+  size_t const mem_addr { mDMAU & 0xFFFFFFE0 };
+  size_t const cache_addr { mDMAL & 0xFFFFFFE0 };
+  size_t lines { ((mDMAU & 0x1F) << 2) | ((mDMAL >> 2) & 0x3) };
+
+  if (lines == 0) {
+    lines = 128;
+  }
+
+  size_t const size { lines * CACHE_LINE_SIZE };
 
-  if (physical_addr >= mMemorySize) {
-    std::cerr << "segfault" << std::endl;
-    std::terminate();
+  // both sides are the same scratch memory if both fault
+  if (mDMAL & 0x10) {
+    std::memmove(&mutableRam(cache_addr, size), &ram(mem_addr, size), size);
+  } else {
+    std::memmove(&mutableRam(mem_addr, size), &ram(cache_addr, size), size);
   }
 
-  return mMemory[physical_addr];
+  // transfers complete immediately: clear trigger and flush
+  mDMAL &= ~0x3u;
 }
 
 // -------------------------------------------------------------------------- //
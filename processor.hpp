@@ -8,6 +8,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
 
 // -------------------------------------------------------------------------- //
 
@@ -39,6 +44,27 @@ enum EGQR : uint8_t {
 
 };
 
+enum ESPR : uint16_t {
+
+  ESPR_XER   = 1,
+  ESPR_LR    = 8,
+  ESPR_CTR   = 9,
+  ESPR_DSISR = 18,
+  ESPR_DAR   = 19,
+  ESPR_GQR0  = 912, // through ESPR_GQR0 + 7
+  ESPR_HID2  = 920,
+  ESPR_DMAU  = 922,
+  ESPR_DMAL  = 923,
+
+};
+
+enum EDSISR : uint32_t {
+
+  EDSISR_PAGE  = 0x40000000, // no translation for the address
+  EDSISR_STORE = 0x02000000, // the access was a store
+
+};
+
 // -------------------------------------------------------------------------- //
 
 class CGPR {
@@ -112,6 +138,14 @@ struct CGQR {
 
 // -------------------------------------------------------------------------- //
 
+// handlers for a memory-mapped device. accesses are 1, 2 or 4 bytes wide and
+// values are in guest (big-endian) order.
+
+using CMMIORead = std::function<uint32_t(size_t addr, size_t size)>;
+using CMMIOWrite = std::function<void(size_t addr, size_t size, uint32_t value)>;
+
+// -------------------------------------------------------------------------- //
+
 class CProcessor {
 
   public:
@@ -119,6 +153,29 @@ class CProcessor {
   CProcessor(size_t memory_size = { 24 * 1024 * 1024 });
   ~CProcessor();
 
+  CProcessor(CProcessor const &) = delete;
+  CProcessor & operator=(CProcessor const &) = delete;
+
+  // maps size bytes of host memory at the page-aligned address addr; pages
+  // mapped more than once (mirrors) share the host memory
+  void map(size_t addr, uint8_t * memory, size_t size);
+
+  // routes loads and stores to the page-aligned range at addr to a device.
+  // these pages never enter the translation cache, so only accesses to them
+  // pay for the dispatch.
+  void mmio(size_t addr, size_t size, CMMIORead read, CMMIOWrite write);
+
+  // registers and memory contents; device state is not included
+  void save(std::ostream & stream) const;
+  bool load(std::istream & stream);
+
+  // baseline() records the current state; reset() returns to it (or to the
+  // power-on state) by rewriting only the memory pages stored to since
+  void baseline();
+  void reset();
+
+  size_t dirtyPages() const;
+
   CGPR & gpr(size_t n);
   CGPR const & gpr(size_t n) const;
 
@@ -140,6 +197,13 @@ class CProcessor {
   uint8_t & xer();
   uint8_t const & xer() const;
 
+  // XER[25-31], the byte count used by lswx/stswx
+  uint8_t & xerCount();
+  uint8_t const & xerCount() const;
+
+  void mtspr(size_t spr, uint32_t value);
+  uint32_t mfspr(size_t spr) const;
+
   size_t ea(int16_t d, size_t ra) const;
   size_t ea(size_t ra, size_t rb) const;
 
@@ -149,19 +213,83 @@ class CProcessor {
   uint32_t lwz(size_t addr) const;
   float lfs(size_t addr) const;
   double lfd(size_t addr) const;
+  uint16_t lhbrx(size_t addr) const;
+  uint32_t lwbrx(size_t addr) const;
 
   void stb(size_t addr, uint8_t b);
   void sth(size_t addr, uint16_t h);
   void stw(size_t addr, uint32_t w);
   void stfs(size_t addr, float s);
   void stfd(size_t addr, double d);
+  void sthbrx(size_t addr, uint16_t h);
+  void stwbrx(size_t addr, uint32_t w);
+
+  void lmw(size_t rt, size_t addr);
+  void stmw(size_t rs, size_t addr);
+  void lsw(size_t rt, size_t addr, size_t count);
+  void stsw(size_t rs, size_t addr, size_t count);
+
+  void dcbz(size_t addr);
+
+  // an access to unmapped memory raises a DSI instead of stopping the host:
+  // the access is dropped (loads read zero), DAR and DSISR describe it and
+  // faulted() stays set until clearFault(), reset() or load()
+  inline bool faulted() const {
+    return mFaulted;
+  }
+
+  void clearFault();
+
+  // host pointer to size bytes of emulated memory at addr, or nullptr if the
+  // range is not entirely mapped. the non-const form marks the range dirty.
+  uint8_t * host(size_t addr, size_t size);
+  uint8_t const * host(size_t addr, size_t size) const;
+
+  static bool IsSPR(size_t spr);
 
   static uint32_t Mask(size_t mb, size_t me);
   static uint32_t Rot32(uint32_t value, size_t bits);
   static bool Carry(uint32_t lhs, uint32_t rhs);
 
+  static constexpr size_t PAGE_BITS { 12 };
+  static constexpr size_t PAGE_SIZE { size_t(1) << PAGE_BITS };
+
+  // 16 KiB of L1 data cache locked as scratchpad memory
+  static constexpr size_t LOCKED_CACHE_ADDR { 0xE0000000 };
+  static constexpr size_t LOCKED_CACHE_SIZE { 16 * 1024 };
+  static constexpr size_t CACHE_LINE_SIZE { 32 };
+
   private:
 
+  // direct-mapped caches of recent translations in front of the two-level
+  // page table. invalid entries hold an address no guest access can match.
+  // pages only enter the write cache once they are marked dirty, so stores
+  // that hit it need no further bookkeeping.
+
+  static constexpr size_t TLB_SIZE { 64 };
+  static constexpr uint64_t TLB_INVALID { uint64_t(1) << 63 };
+
+  struct CTLBEntry {
+
+    uint64_t addr { TLB_INVALID };
+    uint8_t * memory { nullptr };
+
+  };
+
+  struct CPage {
+
+    uint8_t * memory { nullptr };
+    uint16_t device { 0 }; // 1-based index into mDevices, 0 if not MMIO
+
+  };
+
+  struct CDevice {
+
+    CMMIORead read;
+    CMMIOWrite write;
+
+  };
+
   uint8_t * mMemory { nullptr };
   size_t mMemorySize { 0 };
   CGPR mGPR[32];
@@ -171,9 +299,60 @@ class CProcessor {
   uint32_t mLR { 0 };
   uint8_t mCR[8] { 0 };
   uint8_t mXER { 0 };
-
-  uint8_t & ram(size_t addr);
-  uint8_t const & ram(size_t addr) const;
+  uint8_t mXERCount { 0 };
+  uint32_t mHID2 { 0 };
+  uint32_t mDMAU { 0 };
+  uint32_t mDMAL { 0 };
+  uint8_t mLockedCache[LOCKED_CACHE_SIZE] { 0 };
+  mutable bool mFaulted { false };
+  mutable uint32_t mDAR { 0 };
+  mutable uint32_t mDSISR { 0 };
+  mutable uint8_t mFaultSink[PAGE_SIZE] { 0 };
+  std::vector<CPage> mPageTable[1024];
+  mutable CTLBEntry mTLB[TLB_SIZE];
+  CTLBEntry mWriteTLB[TLB_SIZE];
+  std::vector<CDevice> mDevices;
+  std::vector<uint8_t> mDirty;
+  std::vector<uint32_t> mDirtyPages;
+  uint8_t * mBaseline { nullptr };
+  std::string mBaselineState;
+
+  void dma();
+
+  // everything except main memory
+  void saveState(std::ostream & stream) const;
+  bool loadState(std::istream & stream);
+
+  void markDirty(uint8_t const * memory, size_t size);
+  void flushTLB();
+
+  // size must not exceed PAGE_SIZE; use host() for larger ranges
+  uint8_t const & ram(size_t addr, size_t size = 1) const;
+  uint8_t & mutableRam(size_t addr, size_t size = 1);
+
+  // as above, but nullptr without a DSI if the range is not plain memory, so
+  // that multi-word operations can fall back to load() and store() and
+  // reach device pages
+  uint8_t const * mapped(size_t addr, size_t size) const;
+  uint8_t * mutableMapped(size_t addr, size_t size);
+
+  // records a DSI and returns scratch memory for the dropped access
+  uint8_t * fault(size_t addr, size_t size, bool store) const;
+
+  template<typename T>
+  T load(size_t addr) const;
+
+  template<typename T>
+  void store(size_t addr, T value);
+
+  uint8_t * translate(size_t addr, size_t size) const;
+  uint8_t const * readMiss(size_t addr, size_t size) const;
+  uint8_t * writeMiss(size_t addr, size_t size);
+  CPage const * page(size_t addr) const;
+  CPage & mapPage(size_t addr);
+
+  // nullptr if the page at addr is not MMIO
+  CDevice const * device(size_t addr) const;
 
 };
 
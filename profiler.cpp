@@ -0,0 +1,325 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// execution profiler
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "linker.hpp"
+#include "profiler.hpp"
+#include "timing.hpp"
+
+// -------------------------------------------------------------------------- //
+
+CProfiler * gProfiler { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+bool CProfiler::sample() {
+  if (++mTick < SAMPLE_PERIOD) {
+    return false;
+  }
+
+  mTick = 0;
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProfiler::record(
+  std::string_view const key,
+  size_t const line,
+  std::optional<CClock::time_point> const start
+) {
+  COperation & operation { mOperations[key] };
+  ++operation.count;
+  ++mTotal;
+
+  if (start != std::nullopt) {
+    operation.elapsed += (CClock::now() - *start);
+    ++operation.samples;
+  }
+
+  if (line >= mLines.size()) {
+    mLines.resize((line + 1) * 2);
+  }
+
+  ++mLines[line];
+}
+
+// -------------------------------------------------------------------------- //
+
+void CProfiler::report(
+  std::ostream & stream,
+  CSourceMap const & sources,
+  size_t const count
+) const {
+  auto const percent = [this] (uint64_t const n) {
+    return (mTotal > 0 ? (100.0 * double(n) / double(mTotal)) : 0.0);
+  };
+
+  stream << "executed operations: " << mTotal << std::endl;
+  stream << std::fixed << std::setprecision(1);
+
+  stream << "hot lines:" << std::endl;
+
+  auto lines { hotLines() };
+
+  if (lines.size() > count) {
+    lines.resize(count);
+  }
+
+  for (auto const & [line, n] : lines) {
+    stream << "  line " << std::setw(6) << std::left;
+    stream << sources.describe(line) << std::right;
+    stream << std::setw(14) << n << std::setw(7) << percent(n) << '%';
+    stream << std::endl;
+  }
+
+  stream << "hot mnemonics:" << std::endl;
+
+  auto operations { hotOperations() };
+
+  if (operations.size() > count) {
+    operations.resize(count);
+  }
+
+  for (auto const & [key, operation] : operations) {
+    stream << "  " << std::setw(10) << std::left << Mnemonic(key);
+    stream << std::right << std::setw(14) << operation.count;
+    stream << std::setw(7) << percent(operation.count) << '%';
+
+    if (operation.samples > 0) {
+      stream << std::setw(10) << (
+        double(operation.elapsed.count()) / double(operation.samples)
+      ) << " ns/op";
+    }
+
+    stream << std::endl;
+  }
+
+  stream << "host time by family (sampled):" << std::endl;
+
+  for (CFamily const & family : families()) {
+    double const per_op {
+      family.samples > 0 ?
+        (double(family.elapsed.count()) / double(family.samples)) : 0.0
+    };
+
+    stream << "  " << std::setw(14) << std::left << family.name;
+    stream << std::right << std::setw(14) << family.count;
+    stream << std::setw(10) << per_op << " ns/op";
+    stream << std::setw(12) << (per_op * double(family.count) / 1e6);
+    stream << " ms" << std::endl;
+  }
+
+  stream << std::defaultfloat;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CProfiler::write(
+  std::string const & path,
+  CSourceMap const & sources
+) const {
+  std::ofstream stream { path };
+
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  stream << "{\n  \"operations\": " << mTotal << ",\n";
+  stream << "  \"lines\": [";
+
+  bool first { true };
+
+  for (auto const & [line, n] : hotLines()) {
+    stream << (first ? "\n" : ",\n");
+    stream << "    { \"line\": " << sources.lineOf(line);
+
+    if (!sources.fileOf(line).empty()) {
+      stream << ", \"file\": \"" << Escape(sources.fileOf(line)) << "\"";
+    }
+
+    stream << ", \"count\": " << n << " }";
+    first = false;
+  }
+
+  stream << "\n  ],\n  \"mnemonics\": [";
+  first = true;
+
+  for (auto const & [key, operation] : hotOperations()) {
+    stream << (first ? "\n" : ",\n");
+    stream << "    { \"name\": \"" << Escape(Mnemonic(key)) << "\"";
+    stream << ", \"family\": \"" << Escape(Family(key)) << "\"";
+    stream << ", \"count\": " << operation.count;
+    stream << ", \"samples\": " << operation.samples;
+    stream << ", \"sampled_ns\": " << operation.elapsed.count() << " }";
+    first = false;
+  }
+
+  stream << "\n  ],\n  \"families\": [";
+  first = true;
+
+  for (CFamily const & family : families()) {
+    stream << (first ? "\n" : ",\n");
+    stream << "    { \"name\": \"" << Escape(family.name) << "\"";
+    stream << ", \"count\": " << family.count;
+    stream << ", \"samples\": " << family.samples;
+    stream << ", \"sampled_ns\": " << family.elapsed.count() << " }";
+    first = false;
+  }
+
+  stream << "\n  ]\n}\n";
+  return stream.good();
+}
+
+// -------------------------------------------------------------------------- //
+
+std::vector<std::pair<size_t, uint64_t>>
+CProfiler::hotLines() const {
+  std::vector<std::pair<size_t, uint64_t>> lines;
+
+  for (size_t line { 0 }; line < mLines.size(); ++line) {
+    if (mLines[line] > 0) {
+      lines.emplace_back(line, mLines[line]);
+    }
+  }
+
+  std::stable_sort(
+    lines.begin(), lines.end(),
+    [] (auto const & lhs, auto const & rhs) {
+      return (lhs.second > rhs.second);
+    }
+  );
+
+  return lines;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::vector<std::pair<std::string_view, CProfiler::COperation>>
+CProfiler::hotOperations() const {
+  std::vector<std::pair<std::string_view, COperation>> operations {
+    mOperations.begin(), mOperations.end()
+  };
+
+  std::sort(
+    operations.begin(), operations.end(),
+    [] (auto const & lhs, auto const & rhs) {
+      if (lhs.second.count != rhs.second.count) {
+        return (lhs.second.count > rhs.second.count);
+      }
+
+      return (lhs.first < rhs.first);
+    }
+  );
+
+  return operations;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::vector<CProfiler::CFamily>
+CProfiler::families() const {
+  std::vector<CFamily> families;
+
+  for (auto const & [key, operation] : mOperations) {
+    std::string_view const name { Family(key) };
+
+    auto it = std::find_if(
+      families.begin(), families.end(),
+      [name] (CFamily const & family) {
+        return (family.name == name);
+      }
+    );
+
+    if (it == families.end()) {
+      it = families.insert(families.end(), CFamily { name });
+    }
+
+    it->count += operation.count;
+    it->samples += operation.samples;
+    it->elapsed += operation.elapsed;
+  }
+
+  std::sort(
+    families.begin(), families.end(),
+    [] (CFamily const & lhs, CFamily const & rhs) {
+      return (lhs.count > rhs.count);
+    }
+  );
+
+  return families;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string_view CProfiler::Family(
+  std::string_view const key
+) {
+  if (!key.empty() && key[0] == '.') {
+    return "directive";
+  }
+
+  switch (CTiming::Lookup(key).unit) {
+    case EUNIT_IU1: return "integer-muldiv";
+    case EUNIT_FPU: return "float";
+    case EUNIT_LSU: return "load-store";
+    case EUNIT_SRU: return "system";
+    case EUNIT_BPU: return "branch";
+    default: return "integer";
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string_view CProfiler::Mnemonic(
+  std::string_view const key
+) {
+  // registry keys mark optional record/overflow suffixes with a trailing '.'
+  if (key.size() > 1 && key.back() == '.') {
+    return key.substr(0, (key.size() - 1));
+  }
+
+  return key;
+}
+
+// -------------------------------------------------------------------------- //
+
+std::string CProfiler::Escape(
+  std::string_view const text
+) {
+  static char const sHex[] { "0123456789abcdef" };
+  std::string escaped;
+
+  for (char const c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += "\\u00";
+      escaped += sHex[(c >> 4) & 0xF];
+      escaped += sHex[c & 0xF];
+    } else {
+      escaped += c;
+    }
+  }
+
+  return escaped;
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
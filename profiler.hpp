@@ -0,0 +1,93 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_PROFILER_HPP
+#define INCLUDE_PROFILER_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "linker.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// counts executions per source line and per operation. the host time spent in
+// an operation's callback is sampled every SAMPLE_PERIOD executions and scaled
+// up when reported, so timing costs two clock reads per period.
+
+class CProfiler {
+
+  public:
+
+  using CClock = std::chrono::steady_clock;
+
+  static size_t const SAMPLE_PERIOD { 64 };
+
+  bool sample();
+
+  void record(
+    std::string_view key,
+    size_t line,
+    std::optional<CClock::time_point> start
+  );
+
+  // lines are named through sources, which maps them back to their files
+  void report(
+    std::ostream & stream,
+    CSourceMap const & sources,
+    size_t count = 20
+  ) const;
+
+  bool write(std::string const & path, CSourceMap const & sources) const;
+
+  private:
+
+  struct COperation {
+
+    uint64_t count { 0 };
+    uint64_t samples { 0 };
+    std::chrono::nanoseconds elapsed { 0 };
+
+  };
+
+  struct CFamily {
+
+    std::string_view name;
+    uint64_t count { 0 };
+    uint64_t samples { 0 };
+    std::chrono::nanoseconds elapsed { 0 };
+
+  };
+
+  size_t mTick { 0 };
+  uint64_t mTotal { 0 };
+  std::vector<uint64_t> mLines;
+  std::unordered_map<std::string_view, COperation> mOperations;
+
+  std::vector<std::pair<size_t, uint64_t>> hotLines() const;
+  std::vector<std::pair<std::string_view, COperation>> hotOperations() const;
+  std::vector<CFamily> families() const;
+
+  static std::string_view Family(std::string_view key);
+  static std::string_view Mnemonic(std::string_view key);
+  static std::string Escape(std::string_view text);
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern CProfiler * gProfiler;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,285 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// interactive session
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ios>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "interpreter.hpp"
+#include "linker.hpp"
+#include "output.hpp"
+#include "processor.hpp"
+#include "repl.hpp"
+
+// -------------------------------------------------------------------------- //
+
+static char const HELP[] =
+R"(  :regs          general-purpose and condition registers
+  :fprs          floating-point registers
+  :mem ADDR [N]  N bytes of memory at ADDR (default 64)
+  :quit          end the session
+)";
+
+// -------------------------------------------------------------------------- //
+
+CRepl::CRepl(
+  CProcessor & processor,
+  CInterpreter & interpreter
+) :
+  mProcessor { processor },
+  mInterpreter { interpreter }
+{ }
+
+// -------------------------------------------------------------------------- //
+
+void CRepl::run(
+  std::istream & input,
+  std::ostream & output
+) {
+  gStream = &mProgram;
+
+  std::string line;
+
+  for (;;) {
+    // a pending forward branch skips lines until its label is entered
+    output << (mInterpreter.skipping() ? "...   " : "ippc> ") << std::flush;
+
+    if (!std::getline(input, line)) {
+      output << std::endl;
+      return;
+    }
+
+    bool const proceed {
+      (!line.empty() && line[0] == ':') ?
+        command(line, output) : execute(line, output)
+    };
+
+    if (!proceed) {
+      return;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CRepl::execute(
+  std::string_view const line,
+  std::ostream & output
+) {
+  CSourceMap entry;
+  std::optional<std::string> const text {
+    CLinker::Link((std::string { line } + '\n'), ".", &entry)
+  };
+
+  if (text == std::nullopt) {
+    return true;
+  }
+
+  // entered lines are numbered as if the session were a file
+  CSourceMap & sources { mInterpreter.sources() };
+  size_t const mapped { sources.size() };
+  ++mEntered;
+
+  if (entry.size() == 0) {
+    sources.add(0, mEntered);
+  }
+
+  for (size_t i { 1 }; i <= entry.size(); ++i) {
+    std::string_view const file { entry.fileOf(i) };
+
+    if (file.empty()) {
+      sources.add(0, mEntered);
+    } else {
+      sources.add(sources.file(file), entry.lineOf(i));
+    }
+  }
+
+  // everything entered so far has run, so this is where the new line starts
+  mProgram.clear();
+  CInterpreter::CStreamPos const mark { mInterpreter.tell() };
+
+  mProgram.seekp(0, std::ios::end);
+  mProgram << *text;
+  mInterpreter.restart();
+
+  bool failed { false };
+
+  while (mProgram.peek() != std::char_traits<char>::eof()) {
+    if (!mInterpreter.interpret()) {
+      failed = true;
+      break;
+    }
+  }
+
+  gOutput->flush();
+
+  if (!failed) {
+    return true;
+  }
+
+  if (mInterpreter.exitCode() != std::nullopt) {
+    return false;
+  }
+
+  if (mInterpreter.halted() != EHALT_NONE) {
+    output << "stopped after " << mInterpreter.executed() << " operations.";
+    output << std::endl;
+  }
+
+  mInterpreter.restart();
+  mProcessor.clearFault();
+
+  // drop the line (or the module it included), so that branches back over
+  // it do not run it again
+  std::string program { std::move(mProgram).str() };
+  program.resize(size_t(std::streamoff(mark)));
+  mProgram.str(std::move(program));
+  mProgram.clear();
+  mInterpreter.seek(mark);
+  sources.truncate(mapped);
+  --mEntered;
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CRepl::command(
+  std::string_view const line,
+  std::ostream & output
+) {
+  std::istringstream words { std::string { line.substr(1) } };
+  std::string name;
+  words >> name;
+
+  if (name == "q" || name == "quit") {
+    return false;
+  }
+
+  if (name == "r" || name == "regs") {
+    printRegisters(output);
+  } else if (name == "f" || name == "fprs") {
+    printFloats(output);
+  } else if (name == "m" || name == "mem") {
+    std::string addr;
+    std::string size { "64" };
+    words >> addr >> size;
+
+    char * end { nullptr };
+    unsigned long const address { std::strtoul(addr.c_str(), &end, 0) };
+
+    if (addr.empty() || *end != '\0') {
+      output << "usage: :mem ADDR [SIZE]" << std::endl;
+      return true;
+    }
+
+    printMemory(output, address, std::strtoul(size.c_str(), nullptr, 0));
+  } else if (name == "h" || name == "help") {
+    output << HELP;
+  } else {
+    output << "unknown command (see :help)." << std::endl;
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CRepl::printRegisters(
+  std::ostream & output
+) const {
+  auto const word = [&output] (uint32_t const value) {
+    output << "0x" << std::hex << std::setfill('0') << std::setw(8) << value;
+    output << std::dec << std::setfill(' ');
+  };
+
+  for (size_t i { 0 }; i < 32; ++i) {
+    output << 'r' << std::setw(2) << std::left << i << std::right << ' ';
+    word(mProcessor.gpr(i).u32());
+    output << (((i % 4) == 3) ? "\n" : "   ");
+  }
+
+  // architectural field order: LT is the most-significant bit
+  uint32_t cr { 0 };
+
+  for (size_t i { 0 }; i < 8; ++i) {
+    uint8_t const field { mProcessor.cr(i) };
+    uint32_t value { 0 };
+
+    if (field & ECR_LT) { value |= 0b1000; }
+    if (field & ECR_GT) { value |= 0b0100; }
+    if (field & ECR_EQ) { value |= 0b0010; }
+    if (field & ECR_SO) { value |= 0b0001; }
+
+    cr = ((cr << 4) | value);
+  }
+
+  output << "cr  ";
+  word(cr);
+  output << "   lr  ";
+  word(mProcessor.lr());
+  output << "   ctr ";
+  word(mProcessor.ctr());
+  output << "   xer ";
+  word(mProcessor.mfspr(ESPR_XER));
+  output << std::endl;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CRepl::printFloats(
+  std::ostream & output
+) const {
+  for (size_t i { 0 }; i < 32; ++i) {
+    CFPR const & fpr { mProcessor.fpr(i) };
+
+    output << 'f' << std::setw(2) << std::left << i << std::right << ' ';
+    output << std::setw(14) << fpr.f64() << "   ps ";
+    output << std::setw(12) << fpr.ps0() << ' ' << std::setw(12) << fpr.ps1();
+    output << std::endl;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CRepl::printMemory(
+  std::ostream & output,
+  size_t const addr,
+  size_t const size
+) const {
+  uint8_t const * const data { std::as_const(mProcessor).host(addr, size) };
+
+  if (data == nullptr) {
+    output << "unmapped address." << std::endl;
+    return;
+  }
+
+  output << std::hex << std::setfill('0');
+
+  for (size_t i { 0 }; i < size; i += 16) {
+    output << std::setw(8) << (addr + i) << ' ';
+
+    for (size_t j { i }; j < (i + 16) && j < size; ++j) {
+      output << ' ' << std::setw(2) << unsigned(data[j]);
+    }
+
+    output << std::endl;
+  }
+
+  output << std::dec << std::setfill(' ');
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
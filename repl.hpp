@@ -0,0 +1,53 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_REPL_HPP
+#define INCLUDE_REPL_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string_view>
+
+#include "interpreter.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// interactive session on a persistent machine. entered lines are appended to
+// an in-memory program and run as soon as they are complete, so labels and
+// branches back into earlier lines work as they do in a file. a line that
+// fails is reported and dropped from the program. lines starting with ':'
+// are session commands (see :help).
+
+class CRepl {
+
+  public:
+
+  CRepl(CProcessor & processor, CInterpreter & interpreter);
+
+  // runs until .exit, :quit or the end of input
+  void run(std::istream & input, std::ostream & output);
+
+  private:
+
+  CProcessor & mProcessor;
+  CInterpreter & mInterpreter;
+  std::stringstream mProgram;
+  size_t mEntered { 0 }; // entered lines kept in the program
+
+  bool execute(std::string_view line, std::ostream & output);
+  bool command(std::string_view line, std::ostream & output);
+
+  void printRegisters(std::ostream & output) const;
+  void printFloats(std::ostream & output) const;
+  void printMemory(std::ostream & output, size_t addr, size_t size) const;
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,362 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// program server
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "interpreter.hpp"
+#include "linker.hpp"
+#include "output.hpp"
+#include "processor.hpp"
+#include "server.hpp"
+
+// -------------------------------------------------------------------------- //
+
+#if defined(__unix__) || defined(__APPLE__)
+
+static volatile std::sig_atomic_t sStop { 0 };
+
+// ceilings on what one request may ask of a worker; a zero limit in the
+// request selects the ceiling
+static constexpr uint32_t sMaxProgram { (16u << 20) };
+static constexpr uint64_t sMaxInstructions { 10'000'000'000ull };
+static constexpr uint32_t sMaxTimeout { 60'000 };
+
+// -------------------------------------------------------------------------- //
+
+static bool ReadAll(
+  int const fd,
+  void * const data,
+  size_t const size
+) {
+  char * const bytes { static_cast<char *>(data) };
+  size_t done { 0 };
+
+  while (done < size) {
+    ssize_t const n { read(fd, (bytes + done), (size - done)) };
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      return false;
+    }
+
+    done += size_t(n);
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool WriteAll(
+  int const fd,
+  void const * const data,
+  size_t const size
+) {
+  char const * const bytes { static_cast<char const *>(data) };
+  size_t done { 0 };
+
+  while (done < size) {
+    ssize_t const n { write(fd, (bytes + done), (size - done)) };
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      return false;
+    }
+
+    done += size_t(n);
+  }
+
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool Respond(
+  int const connection,
+  int32_t const status,
+  std::string const & text,
+  std::string const & diagnostics
+) {
+  uint32_t const text_size { uint32_t(text.size()) };
+  uint32_t const diagnostics_size { uint32_t(diagnostics.size()) };
+
+  return (
+    WriteAll(connection, &status, sizeof(status)) &&
+    WriteAll(connection, &text_size, sizeof(text_size)) &&
+    WriteAll(connection, text.data(), text_size) &&
+    WriteAll(connection, &diagnostics_size, sizeof(diagnostics_size)) &&
+    WriteAll(connection, diagnostics.data(), diagnostics_size)
+  );
+}
+
+#endif
+
+// -------------------------------------------------------------------------- //
+
+CServer::CMachine::CMachine() :
+  output { text }
+{ }
+
+// -------------------------------------------------------------------------- //
+
+CServer::CServer(
+  size_t const workers
+) :
+  mWorkers { workers }
+{
+  if (mWorkers == 0) {
+    mWorkers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+int CServer::serve(
+  std::string const & path
+) {
+#if defined(__unix__) || defined(__APPLE__)
+  sockaddr_un address {};
+  address.sun_family = AF_UNIX;
+
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    std::cerr << "bad socket path." << std::endl;
+    return 1;
+  }
+
+  std::copy(path.begin(), path.end(), address.sun_path);
+
+  int const listener { socket(AF_UNIX, SOCK_STREAM, 0) };
+
+  if (listener < 0) {
+    std::cerr << "failed to create socket." << std::endl;
+    return 1;
+  }
+
+  unlink(path.c_str());
+
+  sockaddr * const name { reinterpret_cast<sockaddr *>(&address) };
+
+  if (bind(listener, name, sizeof(address)) != 0 ||
+      listen(listener, SOMAXCONN) != 0) {
+    std::cerr << "failed to listen on '" << path << "'." << std::endl;
+    close(listener);
+    return 1;
+  }
+
+  // no SA_RESTART, so waitpid returns when a signal asks us to stop
+  struct sigaction stop {};
+  stop.sa_handler = [] (int) { sStop = 1; };
+  sigaction(SIGINT, &stop, nullptr);
+  sigaction(SIGTERM, &stop, nullptr);
+
+  std::vector<pid_t> workers(mWorkers, -1);
+
+  auto const spawn = [this, listener, &workers] (size_t const index) {
+    pid_t const pid { fork() };
+
+    if (pid == 0) {
+      std::signal(SIGINT, SIG_DFL);
+      std::signal(SIGTERM, SIG_DFL);
+      std::_Exit(work(listener));
+    }
+
+    workers[index] = pid;
+  };
+
+  for (size_t i { 0 }; i < workers.size(); ++i) {
+    spawn(i);
+  }
+
+  std::cerr << "serving on '" << path << "' with " << workers.size();
+  std::cerr << " workers." << std::endl;
+
+  // a worker only exits if something went badly wrong; replace it
+  while (sStop == 0) {
+    pid_t const pid { waitpid(-1, nullptr, 0) };
+
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      break;
+    }
+
+    auto const it = std::find(workers.begin(), workers.end(), pid);
+
+    if (it != workers.end() && sStop == 0) {
+      spawn(size_t(it - workers.begin()));
+    }
+  }
+
+  for (pid_t const pid : workers) {
+    kill(pid, SIGTERM);
+  }
+
+  while (waitpid(-1, nullptr, 0) > 0 || errno == EINTR);
+
+  close(listener);
+  unlink(path.c_str());
+  return 0;
+#else
+  (void)path;
+  std::cerr << "--serve is not available on this platform." << std::endl;
+  return 1;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+int CServer::work(
+  int const listener
+) {
+#if defined(__unix__) || defined(__APPLE__)
+  std::signal(SIGPIPE, SIG_IGN);
+
+  CMachine machine;
+
+  gPPC = &machine.processor;
+  gInterpreter = &machine.interpreter;
+  gStream = &machine.stream;
+  gOutput = &machine.output;
+
+  // errors are reported to the client alongside the output
+  std::cerr.rdbuf(machine.diagnostics.rdbuf());
+
+  for (;;) {
+    int const connection { accept(listener, nullptr, nullptr) };
+
+    if (connection < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+
+      return 1;
+    }
+
+    while (handle(connection, machine));
+    close(connection);
+  }
+#else
+  (void)listener;
+  return 1;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CServer::handle(
+  int const connection,
+  CMachine & machine
+) {
+#if defined(__unix__) || defined(__APPLE__)
+  uint64_t max_instructions { 0 };
+  uint32_t timeout { 0 };
+  uint32_t size { 0 };
+
+  if (!ReadAll(connection, &max_instructions, sizeof(max_instructions)) ||
+      !ReadAll(connection, &timeout, sizeof(timeout)) ||
+      !ReadAll(connection, &size, sizeof(size))) {
+    return false;
+  }
+
+  std::ostringstream rejected;
+
+  if (size > sMaxProgram) {
+    rejected << "program of " << size << " bytes exceeds the server's limit "
+             << "of " << sMaxProgram << " bytes." << std::endl;
+  } else if (max_instructions > sMaxInstructions) {
+    rejected << "instruction limit " << max_instructions << " exceeds the "
+             << "server's limit of " << sMaxInstructions << "." << std::endl;
+  } else if (timeout > sMaxTimeout) {
+    rejected << "timeout of " << timeout << " ms exceeds the server's limit "
+             << "of " << sMaxTimeout << " ms." << std::endl;
+  }
+
+  // the program text is left unread, so the connection is dropped after the
+  // answer rather than read out of step
+  if (!rejected.str().empty()) {
+    Respond(connection, 1, std::string { }, rejected.str());
+    return false;
+  }
+
+  if (max_instructions == 0) {
+    max_instructions = sMaxInstructions;
+  }
+
+  if (timeout == 0) {
+    timeout = sMaxTimeout;
+  }
+
+  std::string program(size, '\0');
+
+  if (!ReadAll(connection, program.data(), size)) {
+    return false;
+  }
+
+  machine.processor.reset();
+  machine.interpreter = CInterpreter { };
+  machine.text.clear();
+  machine.diagnostics.str({});
+  machine.diagnostics.clear();
+
+  // includes resolve against the server's working directory, and modules
+  // stay cached in the worker between requests
+  std::optional<std::string> linked {
+    CLinker::Link(program, ".", &machine.interpreter.sources())
+  };
+
+  machine.stream.clear();
+  machine.stream.str(linked.value_or(std::string { }));
+
+  machine.interpreter.limit(
+    max_instructions, std::chrono::milliseconds { timeout }
+  );
+
+  machine.interpreter.run();
+  machine.output.flush();
+
+  int32_t const status {
+    (linked != std::nullopt) ? machine.interpreter.status() : 1
+  };
+  return Respond(
+    connection, status, machine.text, machine.diagnostics.str()
+  );
+#else
+  (void)connection;
+  (void)machine;
+  return false;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
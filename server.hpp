@@ -0,0 +1,70 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_SERVER_HPP
+#define INCLUDE_SERVER_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "interpreter.hpp"
+#include "output.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+// daemon for running many short programs without paying process startup for
+// each. a pool of pre-forked workers shares one listening Unix socket; each
+// worker keeps a warm machine, serves one connection at a time and resets
+// only the memory pages the previous program stored to.
+//
+// request:  uint64 instruction limit (0: server maximum), uint32 timeout in
+//           ms (0: server maximum), uint32 size, then size bytes of program
+//           text
+// response: int32 status (as the ippc exit status), uint32 size, then size
+//           bytes of output, uint32 size, then size bytes of diagnostics
+//
+// all fields are in host byte order and a connection may carry any number of
+// requests. a request over the server's program size or limits is answered
+// with status 1 and a diagnostic, and its connection is closed.
+
+class CServer {
+
+  public:
+
+  // 0 workers selects one per hardware thread
+  explicit CServer(size_t workers = 0);
+
+  // serves until SIGINT or SIGTERM; the socket file is replaced if it exists
+  int serve(std::string const & path);
+
+  private:
+
+  struct CMachine {
+
+    CMachine();
+
+    CProcessor processor;
+    CInterpreter interpreter;
+    std::istringstream stream;
+    std::string text;
+    COutput output;
+    std::ostringstream diagnostics;
+
+  };
+
+  size_t mWorkers { 0 };
+
+  int work(int listener);
+  bool handle(int connection, CMachine & machine);
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,151 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// machine snapshots
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "interpreter.hpp"
+#include "processor.hpp"
+#include "snapshot.hpp"
+
+// -------------------------------------------------------------------------- //
+
+static uint64_t const MAGIC { 0x33504E5343505049 }; // "IPPCSNP3"
+
+// -------------------------------------------------------------------------- //
+
+// size and FNV-1a hash of the program text, which the saved interpreter
+// positions point into
+static std::pair<uint64_t, uint64_t> Fingerprint() {
+  uint64_t size { 0 };
+  uint64_t hash { 0xCBF29CE484222325 };
+
+  if (gStream == nullptr) {
+    return { size, hash };
+  }
+
+  std::ios::iostate const state { gStream->rdstate() };
+  gStream->clear();
+
+  std::istream::pos_type const position { gStream->tellg() };
+  gStream->seekg(0);
+
+  char buffer[4096];
+
+  while (gStream->read(buffer, sizeof(buffer)) || gStream->gcount() > 0) {
+    size_t const count { size_t(gStream->gcount()) };
+
+    for (size_t i { 0 }; i < count; ++i) {
+      hash = ((hash ^ uint8_t(buffer[i])) * 0x100000001B3);
+    }
+
+    size += count;
+  }
+
+  gStream->clear();
+  gStream->seekg(position);
+  gStream->setstate(state);
+  return { size, hash };
+}
+
+// -------------------------------------------------------------------------- //
+
+void CSnapshot::capture(
+  CProcessor const & processor,
+  CInterpreter const & interpreter
+) {
+  std::ostringstream stream { std::ios::binary };
+  auto const [size, hash] = Fingerprint();
+
+  WriteRaw(stream, MAGIC);
+  WriteRaw(stream, size);
+  WriteRaw(stream, hash);
+  processor.save(stream);
+  interpreter.save(stream);
+  mData = std::move(stream).str();
+}
+
+// -------------------------------------------------------------------------- //
+
+ERestore CSnapshot::restore(
+  CProcessor & processor,
+  CInterpreter & interpreter
+) const {
+  std::istringstream stream { mData, std::ios::binary };
+  uint64_t magic { 0 };
+  uint64_t size { 0 };
+  uint64_t hash { 0 };
+
+  if (
+    !ReadRaw(stream, magic) || magic != MAGIC ||
+    !ReadRaw(stream, size) ||
+    !ReadRaw(stream, hash)
+  ) {
+    return ERESTORE_BAD;
+  }
+
+  // stream positions mean nothing in any other program text
+  if (std::make_pair(size, hash) != Fingerprint()) {
+    return ERESTORE_PROGRAM;
+  }
+
+  if (!processor.load(stream) || !interpreter.load(stream)) {
+    return ERESTORE_BAD;
+  }
+
+  return ERESTORE_OK;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CSnapshot::write(
+  std::string const & path
+) const {
+  std::ofstream stream { path, std::ios::binary };
+
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  stream.write(mData.data(), static_cast<std::streamsize>(mData.size()));
+  return stream.good();
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CSnapshot::read(
+  std::string const & path
+) {
+  std::ifstream stream { path, std::ios::binary };
+
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  mData.assign(
+    std::istreambuf_iterator<char> { stream },
+    std::istreambuf_iterator<char> { }
+  );
+
+  return !stream.bad();
+}
+
+// -------------------------------------------------------------------------- //
+
+bool CSnapshot::empty() const {
+  return mData.empty();
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
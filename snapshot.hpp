@@ -0,0 +1,70 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_SNAPSHOT_HPP
+#define INCLUDE_SNAPSHOT_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "interpreter.hpp"
+#include "processor.hpp"
+
+// -------------------------------------------------------------------------- //
+
+enum ERestore : uint8_t {
+
+  ERESTORE_OK,
+  ERESTORE_BAD,     // not a snapshot, or from another version of ippc
+  ERESTORE_PROGRAM, // taken while running a different program
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// the complete machine state plus the interpreter position, serialized to a
+// compact host-endian image. only non-zero memory pages are stored. the size
+// and a hash of the program text are recorded, since the interpreter
+// position is only valid in the program that took the snapshot.
+
+class CSnapshot {
+
+  public:
+
+  void capture(CProcessor const & processor, CInterpreter const & interpreter);
+  ERestore restore(
+    CProcessor & processor,
+    CInterpreter & interpreter
+  ) const;
+
+  bool write(std::string const & path) const;
+  bool read(std::string const & path);
+
+  bool empty() const;
+
+  private:
+
+  std::string mData;
+
+};
+
+// -------------------------------------------------------------------------- //
+
+template<typename T>
+inline void WriteRaw(std::ostream & stream, T const & value) {
+  stream.write(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+template<typename T>
+inline bool ReadRaw(std::istream & stream, T & value) {
+  return !!stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif
@@ -0,0 +1,365 @@
+// ========================================================================== //
+
+// -------------------------------------------------------------------------- //
+// cycle-cost estimation
+// -------------------------------------------------------------------------- //
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "instruction.hpp"
+#include "span.hpp"
+#include "timing.hpp"
+
+// -------------------------------------------------------------------------- //
+
+CTiming * gTiming { nullptr };
+
+// -------------------------------------------------------------------------- //
+
+// cycles lost refetching after a conditional branch resolves against its
+// static prediction.
+static size_t const MISPREDICT_PENALTY { 2 };
+
+// -------------------------------------------------------------------------- //
+
+struct CLatencyEntry {
+
+  std::string_view key;
+  CLatency latency;
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// worst-case figures from the 750CL user's manual; instructions not listed
+// here are single-cycle integer operations.
+
+static CLatencyEntry const sLatencies[] {
+
+  { "mulli.",  { EUNIT_IU1, 3, 2 } },
+  { "mullw.",  { EUNIT_IU1, 5, 4 } },
+  { "mullwu.", { EUNIT_IU1, 5, 4 } },
+  { "mulhw.",  { EUNIT_IU1, 5, 4 } },
+  { "mulhwu.", { EUNIT_IU1, 6, 5 } },
+  { "divw.",   { EUNIT_IU1, 19, 19 } },
+  { "divwu.",  { EUNIT_IU1, 19, 19 } },
+
+  { "lbz",   { EUNIT_LSU, 2, 1 } },
+  { "lbzx",  { EUNIT_LSU, 2, 1 } },
+  { "lbzu",  { EUNIT_LSU, 2, 1 } },
+  { "lbzux", { EUNIT_LSU, 2, 1 } },
+  { "lhz",   { EUNIT_LSU, 2, 1 } },
+  { "lhzx",  { EUNIT_LSU, 2, 1 } },
+  { "lhzu",  { EUNIT_LSU, 2, 1 } },
+  { "lhzux", { EUNIT_LSU, 2, 1 } },
+  { "lwz",   { EUNIT_LSU, 2, 1 } },
+  { "lwzx",  { EUNIT_LSU, 2, 1 } },
+  { "lwzu",  { EUNIT_LSU, 2, 1 } },
+  { "lwzux", { EUNIT_LSU, 2, 1 } },
+  { "lhbrx", { EUNIT_LSU, 2, 1 } },
+  { "lwbrx", { EUNIT_LSU, 2, 1 } },
+  { "lmw",   { EUNIT_LSU, 2, 1 } },
+  { "lswi",  { EUNIT_LSU, 2, 1 } },
+  { "lswx",  { EUNIT_LSU, 2, 1 } },
+  { "lfs",   { EUNIT_LSU, 2, 1 } },
+  { "lfsx",  { EUNIT_LSU, 2, 1 } },
+  { "lfsu",  { EUNIT_LSU, 2, 1 } },
+  { "lfsux", { EUNIT_LSU, 2, 1 } },
+  { "lfd",   { EUNIT_LSU, 2, 1 } },
+  { "lfdx",  { EUNIT_LSU, 2, 1 } },
+  { "lfdu",  { EUNIT_LSU, 2, 1 } },
+  { "lfdux", { EUNIT_LSU, 2, 1 } },
+
+  { "stb",    { EUNIT_LSU, 1, 1 } },
+  { "stbu",   { EUNIT_LSU, 1, 1 } },
+  { "stbx",   { EUNIT_LSU, 1, 1 } },
+  { "stbux",  { EUNIT_LSU, 1, 1 } },
+  { "sth",    { EUNIT_LSU, 1, 1 } },
+  { "sthu",   { EUNIT_LSU, 1, 1 } },
+  { "sthx",   { EUNIT_LSU, 1, 1 } },
+  { "sthux",  { EUNIT_LSU, 1, 1 } },
+  { "stw",    { EUNIT_LSU, 1, 1 } },
+  { "stwu",   { EUNIT_LSU, 1, 1 } },
+  { "stwx",   { EUNIT_LSU, 1, 1 } },
+  { "stwux",  { EUNIT_LSU, 1, 1 } },
+  { "sthbrx", { EUNIT_LSU, 1, 1 } },
+  { "stwbrx", { EUNIT_LSU, 1, 1 } },
+  { "stmw",   { EUNIT_LSU, 1, 1 } },
+  { "stswi",  { EUNIT_LSU, 1, 1 } },
+  { "stswx",  { EUNIT_LSU, 1, 1 } },
+  { "stfs",   { EUNIT_LSU, 1, 1 } },
+  { "stfsx",  { EUNIT_LSU, 1, 1 } },
+  { "stfsu",  { EUNIT_LSU, 1, 1 } },
+  { "stfsux", { EUNIT_LSU, 1, 1 } },
+  { "stfd",   { EUNIT_LSU, 1, 1 } },
+  { "stfdx",  { EUNIT_LSU, 1, 1 } },
+  { "stfdu",  { EUNIT_LSU, 1, 1 } },
+  { "stfdux", { EUNIT_LSU, 1, 1 } },
+
+  { "fmr.",     { EUNIT_FPU, 3, 1 } },
+  { "fabs.",    { EUNIT_FPU, 3, 1 } },
+  { "fnabs.",   { EUNIT_FPU, 3, 1 } },
+  { "fneg.",    { EUNIT_FPU, 3, 1 } },
+  { "frsp.",    { EUNIT_FPU, 3, 1 } },
+  { "fadds.",   { EUNIT_FPU, 3, 1 } },
+  { "fsubs.",   { EUNIT_FPU, 3, 1 } },
+  { "fmuls.",   { EUNIT_FPU, 3, 1 } },
+  { "fmadds.",  { EUNIT_FPU, 3, 1 } },
+  { "fmsubs.",  { EUNIT_FPU, 3, 1 } },
+  { "fnmadds.", { EUNIT_FPU, 3, 1 } },
+  { "fnmsubs.", { EUNIT_FPU, 3, 1 } },
+  { "fadd.",    { EUNIT_FPU, 3, 1 } },
+  { "fsub.",    { EUNIT_FPU, 3, 1 } },
+  { "fmul.",    { EUNIT_FPU, 4, 2 } },
+  { "fmadd.",   { EUNIT_FPU, 4, 2 } },
+  { "fmsub.",   { EUNIT_FPU, 4, 2 } },
+  { "fnmadd.",  { EUNIT_FPU, 4, 2 } },
+  { "fnmsub.",  { EUNIT_FPU, 4, 2 } },
+  { "fdivs.",   { EUNIT_FPU, 17, 17 } },
+  { "fdiv.",    { EUNIT_FPU, 31, 31 } },
+  { "fres.",    { EUNIT_FPU, 10, 10 } },
+  { "frsqrte.", { EUNIT_FPU, 3, 1 } },
+  { "fsqrts.",  { EUNIT_FPU, 31, 31 } },
+  { "fsqrt.",   { EUNIT_FPU, 31, 31 } },
+
+  { "mtctr", { EUNIT_SRU, 2, 2 } },
+  { "mtlr",  { EUNIT_SRU, 2, 2 } },
+  { "mfctr", { EUNIT_SRU, 1, 1 } },
+  { "mflr",  { EUNIT_SRU, 1, 1 } },
+  { "mtxer", { EUNIT_SRU, 2, 2 } },
+  { "mfxer", { EUNIT_SRU, 1, 1 } },
+  { "mtspr", { EUNIT_SRU, 2, 2 } },
+  { "mfspr", { EUNIT_SRU, 3, 3 } },
+
+  { "dcbz",   { EUNIT_LSU, 3, 3 } },
+  { "dcbz_l", { EUNIT_LSU, 3, 3 } },
+  { "dcbf",   { EUNIT_LSU, 3, 3 } },
+  { "dcbst",  { EUNIT_LSU, 3, 3 } },
+  { "dcbi",   { EUNIT_LSU, 3, 3 } },
+  { "dcbt",   { EUNIT_LSU, 1, 1 } },
+
+};
+
+// -------------------------------------------------------------------------- //
+
+CTiming::CTiming() = default;
+
+// -------------------------------------------------------------------------- //
+
+void CTiming::retire(
+  CInstruction const & instruction,
+  CSpanT<int32_t> args,
+  CSpanT<std::string_view> names,
+  std::string_view const name
+) {
+  auto it = mLatencies.find(&instruction);
+
+  if (it == mLatencies.end()) {
+    it = mLatencies.emplace(&instruction, Lookup(instruction.key)).first;
+  }
+
+  CLatency const & latency { it->second };
+  CRegion & stats { region(name) };
+  ++stats.instructions;
+  ++mInstructions;
+
+  if (latency.unit == EUNIT_BPU) {
+    return;
+  }
+
+  // a register operand is a destination if it names the target (RT, RD, FRT,
+  // FRD, BF) or it is the leading RA of a logical/rotate form (RA, RS, ...).
+
+  bool const ra_target {
+    names.size() > 1 && names[0] == "RA" && names[1] == "RS"
+  };
+
+  uint64_t dispatch { mCycle };
+  uint64_t * targets[2] { nullptr, nullptr };
+  size_t target_count { 0 };
+
+  for (size_t i { 0 }; i < args.size(); ++i) {
+    std::string_view const operand { names[i] };
+    auto const n = size_t(args[i]);
+    uint64_t * ready { nullptr };
+
+    if (operand == "BF") {
+      ready = &mCRReady[n & 7];
+    } else if (!operand.empty() && operand[0] == 'F') {
+      ready = &mFPRReady[n & 31];
+    } else if (!operand.empty() && operand[0] == 'R') {
+      ready = &mGPRReady[n & 31];
+    } else {
+      continue;
+    }
+
+    bool const target {
+      operand == "RT" || operand == "RD" ||
+      operand == "FRT" || operand == "FRD" ||
+      operand == "BF" || (i == 0 && ra_target)
+    };
+
+    if (!target) {
+      dispatch = std::max(dispatch, *ready);
+    } else if (target_count < 2) {
+      targets[target_count++] = ready;
+    }
+  }
+
+  EUnit unit { latency.unit };
+
+  if (unit == EUNIT_IU) {
+    unit = (
+      mUnitFree[EUNIT_IU2] <= mUnitFree[EUNIT_IU1] ? EUNIT_IU2 : EUNIT_IU1
+    );
+  }
+
+  dispatch = std::max(dispatch, mUnitFree[unit]);
+
+  if (dispatch == mCycle && mDispatched >= 2) {
+    ++dispatch;
+  }
+
+  if (dispatch > mCycle) {
+    stats.cycles += (dispatch - mCycle);
+    mCycle = dispatch;
+    mDispatched = 0;
+  }
+
+  ++mDispatched;
+  mUnitFree[unit] = (dispatch + latency.busy);
+
+  for (size_t i { 0 }; i < target_count; ++i) {
+    *targets[i] = (dispatch + latency.latency);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void CTiming::stall(
+  size_t const cycles,
+  std::string_view const name
+) {
+  region(name).cycles += cycles;
+  mCycle += cycles;
+  mDispatched = 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CTiming::mispredict(
+  std::string_view const name
+) {
+  stall(MISPREDICT_PENALTY, name);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t CTiming::now() const {
+  return mCycle;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t CTiming::cycles() const {
+  uint64_t cycles { mCycle };
+
+  for (uint64_t const free : mUnitFree) {
+    cycles = std::max(cycles, free);
+  }
+
+  for (uint64_t const ready : mGPRReady) {
+    cycles = std::max(cycles, ready);
+  }
+
+  for (uint64_t const ready : mFPRReady) {
+    cycles = std::max(cycles, ready);
+  }
+
+  return cycles;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t CTiming::instructions() const {
+  return mInstructions;
+}
+
+// -------------------------------------------------------------------------- //
+
+void CTiming::report(
+  std::ostream & stream
+) const {
+  std::vector<std::pair<std::string_view, CRegion>> regions;
+
+  for (auto const & [name, stats] : mRegions) {
+    regions.emplace_back(name, stats);
+  }
+
+  std::stable_sort(
+    regions.begin(), regions.end(),
+    [] (auto const & lhs, auto const & rhs) {
+      return (lhs.second.cycles > rhs.second.cycles);
+    }
+  );
+
+  stream << "estimated cycles: " << cycles();
+  stream << " (" << mInstructions << " instructions)" << std::endl;
+
+  for (auto const & [name, stats] : regions) {
+    double const cpi {
+      stats.instructions > 0 ?
+        (double(stats.cycles) / double(stats.instructions)) : 0.0
+    };
+
+    stream << std::setw(12) << stats.cycles << ' ';
+    stream << std::setw(12) << stats.instructions << ' ';
+    stream << std::fixed << std::setprecision(2) << std::setw(6) << cpi;
+    stream << std::defaultfloat << "  ";
+    stream << (name.empty() ? "<entry>" : name) << std::endl;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+CLatency CTiming::Lookup(
+  std::string_view const key
+) {
+  for (CLatencyEntry const & entry : sLatencies) {
+    if (entry.key == key) {
+      return entry.latency;
+    }
+  }
+
+  if (!key.empty() && key[0] == 'b') {
+    return { EUNIT_BPU, 0, 0 };
+  }
+
+  return { };
+}
+
+// -------------------------------------------------------------------------- //
+
+CTiming::CRegion &
+CTiming::region(
+  std::string_view const name
+) {
+  auto it = mRegions.find(name);
+
+  if (it == mRegions.end()) {
+    it = mRegions.emplace(std::string { name }, CRegion { }).first;
+  }
+
+  return it->second;
+}
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
@@ -0,0 +1,107 @@
+// ========================================================================== //
+
+#ifndef INCLUDE_TIMING_HPP
+#define INCLUDE_TIMING_HPP
+
+// -------------------------------------------------------------------------- //
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "instruction.hpp"
+#include "span.hpp"
+
+// -------------------------------------------------------------------------- //
+
+enum EUnit : uint8_t {
+
+  EUNIT_IU,  // either integer unit
+  EUNIT_IU1, // integer unit 1 (multiply/divide)
+  EUNIT_IU2, // integer unit 2
+  EUNIT_FPU, // floating-point unit
+  EUNIT_LSU, // load/store unit
+  EUNIT_SRU, // system-register unit
+  EUNIT_BPU, // branch-processing unit (folded)
+
+  EUNIT_COUNT,
+
+};
+
+// -------------------------------------------------------------------------- //
+
+struct CLatency {
+
+  EUnit unit { EUNIT_IU };
+  uint8_t latency { 1 }; // cycles until the result may be consumed
+  uint8_t busy { 1 };    // cycles the unit is occupied (1 = pipelined)
+
+};
+
+// -------------------------------------------------------------------------- //
+
+// estimates Gekko cycle counts with an in-order, dual-dispatch pipeline model.
+// each retired instruction dispatches once its source registers are ready and
+// its execution unit is free; at most two instructions dispatch per cycle and
+// branches are folded out of the dispatch stream.
+
+class CTiming {
+
+  public:
+
+  CTiming();
+
+  void retire(
+    CInstruction const & instruction,
+    CSpanT<int32_t> args,
+    CSpanT<std::string_view> names,
+    std::string_view region
+  );
+
+  void stall(size_t cycles, std::string_view region);
+  void mispredict(std::string_view region);
+
+  uint64_t now() const;
+  uint64_t cycles() const;
+  uint64_t instructions() const;
+
+  void report(std::ostream & stream) const;
+
+  static CLatency Lookup(std::string_view key);
+
+  private:
+
+  struct CRegion {
+
+    uint64_t cycles { 0 };
+    uint64_t instructions { 0 };
+
+  };
+
+  uint64_t mCycle { 0 };
+  uint64_t mInstructions { 0 };
+  uint8_t mDispatched { 0 };
+  uint64_t mUnitFree[EUNIT_COUNT] { 0 };
+  uint64_t mGPRReady[32] { 0 };
+  uint64_t mFPRReady[32] { 0 };
+  uint64_t mCRReady[8] { 0 };
+  std::unordered_map<CInstruction const *, CLatency> mLatencies;
+  std::map<std::string, CRegion, std::less<>> mRegions;
+
+  CRegion & region(std::string_view name);
+
+};
+
+// -------------------------------------------------------------------------- //
+
+extern CTiming * gTiming;
+
+// -------------------------------------------------------------------------- //
+
+// ========================================================================== //
+
+#endif